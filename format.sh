@@ -5,4 +5,5 @@ clang-format -i include/hqlockfree/*.hpp
 clang-format -i src/hqlockfree/*.cpp
 clang-format -i tests/*.cpp
 clang-format -i perf/*.cpp
+clang-format -i perf/*.hpp
 clang-format -i examples/*.cpp
\ No newline at end of file
@@ -12,28 +12,114 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace hqlockfree {
 
 /** @brief Conventional x86‑64 cache line size in bytes. */
 static inline constexpr size_t cache_line_size = 64UL;
 
+/* -----------------------------------------------------------------------
+ *  Destructive interference size – the padding granularity
+ * ---------------------------------------------------------------------*/
+
+/**
+ * @brief Minimum distance between two independently written objects for them
+ *        not to false‑share; the padding used by @ref cache_padded, the queue
+ *        cursors and (by default) oversized ring slots.
+ *
+ * Set with `-DHQLOCKFREE_DESTRUCTIVE_INTERFERENCE_SIZE=128` (CMake option of
+ * the same name) for CPUs whose adjacent‑line prefetcher pairs lines, or
+ * with 128‑byte lines.  Otherwise `std::hardware_destructive_interference_size`
+ * where the standard library provides it, else @ref cache_line_size.  It
+ * changes the layout of every queue, so it must agree across translation
+ * units; `probe_interference()` (interference.hpp) suggests a value.
+ */
+#if defined(HQLOCKFREE_DESTRUCTIVE_INTERFERENCE_SIZE)
+static inline constexpr size_t destructive_interference_size =
+    HQLOCKFREE_DESTRUCTIVE_INTERFERENCE_SIZE;
+#elif defined(__cpp_lib_hardware_interference_size)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+static inline constexpr size_t destructive_interference_size =
+    std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+static inline constexpr size_t destructive_interference_size = cache_line_size;
+#endif
+
+static_assert(destructive_interference_size >= cache_line_size &&
+                  (destructive_interference_size &
+                   (destructive_interference_size - 1)) == 0,
+              "destructive interference size must be a power‑of‑two multiple "
+              "of the cache line size");
+
 /**
- * @brief Helper that pads an object to occupy an entire cache line, preventing
- *        false sharing between adjacent objects.
+ * @brief Helper that pads an object to occupy an entire cache line (or
+ *        @ref destructive_interference_size block), preventing false sharing
+ *        between adjacent objects.
  *
  * Inherits publicly from @p T so that it can be used anywhere a @p T is
  * expected while guaranteeing unique cache line residency.
  */
-template <typename T> struct alignas(cache_line_size) cache_padded : T {
+template <typename T>
+struct alignas(destructive_interference_size) cache_padded : T {
     using T::T; ///< Perfect‑forward the base constructors.
 };
 
+/**
+ * @brief Ask the CPU to pull the line holding @p address into all cache
+ *        levels, in exclusive state if @p for_write.  A no‑op where the
+ *        compiler offers no prefetch builtin.
+ */
+template <bool for_write = false>
+inline void prefetch_line(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, for_write ? 1 : 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+/**
+ * @brief Default `prefetch_policy` of the queues: never prefetches.  Empty,
+ *        so push and pop compile exactly as without the parameter.
+ */
+struct no_prefetch {
+    template <bool for_write, typename buffer>
+    void ahead(const buffer&, uint64_t) const {}
+};
+
+/**
+ * @brief `prefetch_policy` that prefetches `distance` slots ahead of each
+ *        push (for write) and pop (for read); 0 disables it.  A plain
+ *        member: set it through the container's `prefetch()` before the
+ *        container is shared, then only the hot paths read it.  Tune with
+ *        prefetch_benchmarks.
+ */
+struct tunable_prefetch {
+    size_t distance = 0; ///< slots ahead, 0 = off
+
+    template <bool for_write, typename buffer>
+    void ahead(const buffer& ring, uint64_t index) const {
+        if (distance != 0)
+            ring.template prefetch<for_write>(index + distance);
+    }
+};
+
 /* =======================================================================
  * Compile‑time utilities for powers‑of‑two arithmetic
  * =====================================================================*/
@@ -115,15 +201,58 @@ struct elements_per_cache_line<T, cache_size_policy::pow2> {
  *  cache_line – storage block aligned + sized to a single cache line
  * ---------------------------------------------------------------------*/
 
+/**
+ * @brief Alignment of one @ref cache_line of @p T.
+ *
+ * Elements that fit in a line keep the line alignment.  A @p T larger than a
+ * line gets a slot of its own, aligned – and therefore sized – to a whole
+ * multiple of @p interference_size, so no two slots share a line and, with
+ * 128, no two slots share the adjacent‑line prefetcher's 128‑byte pair.
+ */
+template <typename T,
+          size_t interference_size = destructive_interference_size>
+inline constexpr size_t slot_alignment =
+    (sizeof(T) > cache_line_size) ? interference_size : cache_line_size;
+
 /// @brief  cache_line – storage block aligned + sized to a single cache line
-template <typename T, cache_size_policy size_policy>
-struct alignas(cache_line_size) cache_line
+/// (or to whole @p interference_size blocks for an oversized @p T).
+template <typename T, cache_size_policy size_policy,
+          size_t interference_size = destructive_interference_size>
+struct alignas(slot_alignment<T, interference_size>) cache_line
     : std::array<T, elements_per_cache_line<T, size_policy>::value> {
+    static_assert(interference_size >= cache_line_size &&
+                      pow2_factory::upper(interference_size) ==
+                          interference_size,
+                  "interference_size must be a power‑of‑two multiple of the "
+                  "cache line size");
+
     using std::array<T, elements_per_cache_line<T, size_policy>::value>::array;
     static constexpr size_t number_of_elements =
         elements_per_cache_line<T, size_policy>::value;
 };
 
+/* -----------------------------------------------------------------------
+ *  raw_slot – storage for one element whose lifetime the owner manages
+ * ---------------------------------------------------------------------*/
+
+/**
+ * @brief Uninitialised, correctly sized and aligned storage for one @p T.
+ *
+ * Constructing a line of these does nothing, so a ring of a million slots
+ * costs no constructor calls up front and @p T needs no default constructor.
+ * The owner placement‑constructs `value` and destroys it again; the slot
+ * itself never touches it.
+ */
+template <typename T> union raw_slot {
+    T value;
+
+    constexpr raw_slot() noexcept {}
+    ~raw_slot()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+    ~raw_slot() {}
+};
+
 /* -----------------------------------------------------------------------
  *  Index helpers – mod/div vs. bit‑mask/shift depending on policy
  * ---------------------------------------------------------------------*/
@@ -164,65 +293,355 @@ template <> class div_indexer<cache_size_policy::pow2> {
     size_t operator()(const size_t index) const { return index >> m_shift; }
 };
 
+/* -----------------------------------------------------------------------
+ *  Buffer sizing shared by the runtime‑ and compile‑time‑sized buffers
+ * ---------------------------------------------------------------------*/
+
+/// @brief Number of cache lines holding at least @p minimum_cache_lines
+/// lines or @p minimum_elements elements; a power‑of‑two for *pow2*.
+template <typename T, cache_size_policy size_policy>
+constexpr size_t buffer_cache_lines(const size_t minimum_cache_lines,
+                                    const size_t minimum_elements) {
+    constexpr size_t per_line = elements_per_cache_line<T, size_policy>::value;
+    const size_t lines = std::max(
+        minimum_cache_lines, (minimum_elements + (per_line - 1U)) / per_line);
+    if constexpr (size_policy == cache_size_policy::exact) {
+        return lines;
+    }
+    return pow2_factory::upper(lines);
+}
+
+/* -----------------------------------------------------------------------
+ *  Bulk copy kernels shared by the runtime‑ and compile‑time‑sized buffers
+ * ---------------------------------------------------------------------*/
+
+namespace detail {
+
+/**
+ * @brief Call `run(slot, n)` for each run of [@p first, @p first + @p count)
+ *        whose slots sit exactly one line apart.
+ *
+ * Index i lives in line `i % lines` at position `(i % size) / lines`, so
+ * consecutive indices walk across the lines at a fixed position; a run ends
+ * where the line index wraps to 0.  The mod / div happen once per run, not
+ * once per element.
+ */
+template <typename line_type, typename visitor>
+void for_each_slot_run(line_type* lines, const size_t number_of_lines,
+                       const size_t per_line, size_t first, size_t count,
+                       visitor&& run) {
+    const size_t size = number_of_lines * per_line;
+    while (count != 0) {
+        const size_t flat = first % size;
+        const size_t line = flat % number_of_lines;
+        const size_t n = std::min(count, number_of_lines - line);
+        run(&lines[line][flat / number_of_lines], n);
+        first += n;
+        count -= n;
+    }
+}
+
+/**
+ * @brief Copy kernels for one run of slots @p stride bytes apart.
+ *
+ * Trivially copyable elements are moved with `memcpy`: a single call when
+ * the slots are contiguous (`stride == sizeof(T)`, i.e. one element filling
+ * each line exactly), otherwise one fixed‑size copy per slot at a constant
+ * stride – a strided scatter / gather the compiler unrolls.  Other types go
+ * through their constructors one by one.
+ */
+template <typename T, size_t stride> struct slot_run {
+    static constexpr bool trivial = std::is_trivially_copyable_v<T>;
+    static constexpr bool contiguous = (stride == sizeof(T));
+
+    static raw_slot<T>* at(raw_slot<T>* slots, const size_t k) {
+        return reinterpret_cast<raw_slot<T>*>(
+            reinterpret_cast<std::byte*>(slots) + k * stride);
+    }
+    static const raw_slot<T>* at(const raw_slot<T>* slots, const size_t k) {
+        return reinterpret_cast<const raw_slot<T>*>(
+            reinterpret_cast<const std::byte*>(slots) + k * stride);
+    }
+
+    /// @brief Construct @p n slots from @p from.
+    static void scatter(raw_slot<T>* slots, const T* from, const size_t n) {
+        if constexpr (trivial && contiguous) {
+            std::memcpy(static_cast<void*>(slots), from, n * sizeof(T));
+        } else if constexpr (trivial) {
+            for (size_t k = 0; k < n; k++)
+                std::memcpy(static_cast<void*>(at(slots, k)), from + k,
+                            sizeof(T));
+        } else {
+            for (size_t k = 0; k < n; k++)
+                std::construct_at(&at(slots, k)->value, from[k]);
+        }
+    }
+
+    /// @brief Copy @p n slots out to @p to, leaving them alive.
+    static void gather(const raw_slot<T>* slots, T* to, const size_t n) {
+        if constexpr (trivial && contiguous) {
+            std::memcpy(to, static_cast<const void*>(slots), n * sizeof(T));
+        } else if constexpr (trivial) {
+            for (size_t k = 0; k < n; k++)
+                std::memcpy(to + k, static_cast<const void*>(at(slots, k)),
+                            sizeof(T));
+        } else {
+            for (size_t k = 0; k < n; k++)
+                to[k] = at(slots, k)->value;
+        }
+    }
+
+    /// @brief Move @p n slots out to @p to and end their lifetime.
+    static void take(raw_slot<T>* slots, T* to, const size_t n) {
+        if constexpr (trivial) {
+            gather(slots, to, n);
+        } else {
+            for (size_t k = 0; k < n; k++) {
+                to[k] = std::move(at(slots, k)->value);
+                std::destroy_at(&at(slots, k)->value);
+            }
+        }
+    }
+};
+
+} // namespace detail
+
 /* -----------------------------------------------------------------------
  *  false_sharing_optimized_buffer – 2‑D view onto contiguous cache lines
  * ---------------------------------------------------------------------*/
 
 /// @brief false_sharing_optimized_buffer – 2‑D view onto contiguous cache lines
-template <typename T, cache_size_policy size_policy>
+///
+/// Slots start out *uninitialised* (see @ref raw_slot): the owner constructs
+/// an element with construct(), reads it through get() / operator[] and ends
+/// its lifetime with destroy().  Elements still alive when the buffer is
+/// destroyed are the owner's to destroy first.
+///
+/// @p allocator supplies the backing storage; it is rebound to
+/// `cache_line_type` (see mmap_allocator.hpp for a huge‑page backend).
+/// @p interference_size pads slots of elements larger than a cache line (see
+/// @ref slot_alignment).
+template <typename T, cache_size_policy size_policy,
+          typename allocator = std::allocator<T>,
+          size_t interference_size = destructive_interference_size>
 class alignas(cache_line_size) false_sharing_optimized_buffer {
   public:
-    using cache_line_type = cache_line<T, size_policy>;
+    using cache_line_type =
+        cache_line<raw_slot<T>, size_policy, interference_size>;
+    using line_allocator = typename std::allocator_traits<
+        allocator>::template rebind_alloc<cache_line_type>;
     /// @brief Alias for the number of elements per cache line *for this T*.
     static constexpr size_t cache_line_size =
         elements_per_cache_line<T, size_policy>::value;
+    /// @brief Capacity known at compile time, 0 = sized at construction.
+    static constexpr size_t static_size = 0;
 
   private:
-    /* Helpers
-     * ----------------------------------------------------------------*/
-    /// @brief Ensures *pow2* policy allocates a power‑of‑two cache‑line count.
-    size_t calc_min_cache_lines(size_t min_cache_lines) {
-        if constexpr (size_policy == cache_size_policy::exact) {
-            return min_cache_lines;
-        }
-        return pow2_factory::upper(min_cache_lines);
-    }
+    using line_traits = std::allocator_traits<line_allocator>;
+    using run_kernels = detail::slot_run<T, sizeof(cache_line_type)>;
 
     /* Data
      * --------------------------------------------------------------------*/
-    std::vector<cache_line_type> m_lines;  ///< backing storage
+    [[no_unique_address]] line_allocator m_allocator;
+    const size_t m_number_of_lines;
+    /// @brief Backing storage.
+    typename line_traits::pointer m_lines;
     mod_indexer<size_policy> m_mod_index;  ///< cache‑line index
     div_indexer<size_policy> m_div_index;  ///< element index inside line
     mod_indexer<size_policy> m_mod_index2; ///< second mod for flat view
 
+    raw_slot<T>& slot(const size_t idx) const {
+        return m_lines[m_mod_index(idx)][m_div_index(m_mod_index2(idx))];
+    }
+
   public:
     /**
      * @brief Construct with at least @p minimum_cache_lines lines OR
-     *        @p minimum_elements elements, whichever is larger.
+     *        @p minimum_elements elements, whichever is larger, in storage
+     *        obtained from @p alloc.  No element is constructed.
      */
-    explicit false_sharing_optimized_buffer(const size_t minimum_cache_lines,
-                                            const size_t minimum_elements = 0)
-        : m_lines(
-              std::max(calc_min_cache_lines(minimum_cache_lines),
-                       (minimum_elements +
-                        (elements_per_cache_line<T, size_policy>::value - 1U)) /
-                           (elements_per_cache_line<T, size_policy>::value))),
-          m_mod_index(m_lines.size()), m_div_index(m_lines.size()),
-          m_mod_index2(size()) {}
-
-    /* Random access */
-    T& get(const size_t& idx) {
-        return m_lines[m_mod_index(idx)][m_div_index(m_mod_index2(idx))];
+    explicit false_sharing_optimized_buffer(
+        const size_t minimum_cache_lines, const size_t minimum_elements = 0,
+        const allocator& alloc = allocator())
+        : m_allocator(alloc),
+          m_number_of_lines(buffer_cache_lines<T, size_policy>(
+              minimum_cache_lines, minimum_elements)),
+          m_lines(line_traits::allocate(m_allocator, m_number_of_lines)),
+          m_mod_index(m_number_of_lines), m_div_index(m_number_of_lines),
+          m_mod_index2(size()) {
+        /* a no‑op loop: raw slots have nothing to initialise */
+        std::uninitialized_default_construct_n(m_lines, m_number_of_lines);
     }
-    const T& get(const size_t& idx) const {
-        return m_lines[m_mod_index(idx)][m_div_index(m_mod_index2(idx))];
+
+    ~false_sharing_optimized_buffer() {
+        std::destroy_n(m_lines, m_number_of_lines);
+        line_traits::deallocate(m_allocator, m_lines, m_number_of_lines);
+    }
+
+    false_sharing_optimized_buffer(const false_sharing_optimized_buffer&) =
+        delete;
+    false_sharing_optimized_buffer&
+    operator=(const false_sharing_optimized_buffer&) = delete;
+
+    /* Element lifetime */
+    template <typename... Args>
+    T& construct(const size_t& idx, Args&&... args) {
+        return *std::construct_at(&slot(idx).value,
+                                  std::forward<Args>(args)...);
     }
+    void destroy(const size_t& idx) { std::destroy_at(&slot(idx).value); }
+
+    /* Random access to constructed elements */
+    T& get(const size_t& idx) { return slot(idx).value; }
+    const T& get(const size_t& idx) const { return slot(idx).value; }
     T& operator[](const size_t& idx) { return get(idx); }
     const T& operator[](const size_t& idx) const { return get(idx); }
 
+    /// @brief Prefetch the line holding slot @p idx (see prefetch_line).
+    template <bool for_write = false> void prefetch(const size_t idx) const {
+        prefetch_line<for_write>(&slot(idx));
+    }
+    /// @brief Write every line once so its pages are mapped and the lines
+    /// cached; only while no slot is alive.
+    void touch() {
+        std::memset(static_cast<void*>(std::to_address(m_lines)), 0,
+                    m_number_of_lines * sizeof(cache_line_type));
+    }
+
+    /* Bulk copies (see detail::slot_run) */
+    /// @brief Construct [@p first, @p first + @p count) from @p from.
+    void write_n(const size_t first, const T* from, const size_t count) {
+        detail::for_each_slot_run(
+            m_lines, m_number_of_lines, cache_line_size, first, count,
+            [&](raw_slot<T>* slots, size_t n) {
+                run_kernels::scatter(slots, from, n);
+                from += n;
+            });
+    }
+    /// @brief Copy [@p first, @p first + @p count) out to @p to.
+    void copy_n(const size_t first, T* to, const size_t count) const {
+        detail::for_each_slot_run(
+            static_cast<const cache_line_type*>(m_lines), m_number_of_lines,
+            cache_line_size, first, count,
+            [&](const raw_slot<T>* slots, size_t n) {
+                run_kernels::gather(slots, to, n);
+                to += n;
+            });
+    }
+    /// @brief Move [@p first, @p first + @p count) out to @p to and destroy.
+    void take_n(const size_t first, T* to, const size_t count) {
+        detail::for_each_slot_run(
+            m_lines, m_number_of_lines, cache_line_size, first, count,
+            [&](raw_slot<T>* slots, size_t n) {
+                run_kernels::take(slots, to, n);
+                to += n;
+            });
+    }
+
     /* Introspection */
-    size_t number_of_cache_lines() const { return m_lines.size(); }
+    size_t number_of_cache_lines() const { return m_number_of_lines; }
     size_t size() const { return number_of_cache_lines() * cache_line_size; }
 };
 
+/* -----------------------------------------------------------------------
+ *  fixed_false_sharing_optimized_buffer – compile‑time‑sized variant
+ * ---------------------------------------------------------------------*/
+
+/**
+ * @brief Same layout as @ref false_sharing_optimized_buffer, sized for at
+ *        least @p minimum_elements at compile time and stored inline in a
+ *        `std::array`.
+ *
+ * Every index computation is against a constant, so the mod / div collapse to
+ * masks and shifts (*pow2*) or multiply‑by‑reciprocal (*exact*) with no loads
+ * from the object, and the buffer needs no heap: it can live in static
+ * storage or shared memory.
+ */
+template <typename T, cache_size_policy size_policy, size_t minimum_elements,
+          size_t interference_size = destructive_interference_size>
+class alignas(cache_line_size) fixed_false_sharing_optimized_buffer {
+  public:
+    using cache_line_type =
+        cache_line<raw_slot<T>, size_policy, interference_size>;
+    static constexpr size_t cache_line_size =
+        elements_per_cache_line<T, size_policy>::value;
+    static constexpr size_t lines =
+        buffer_cache_lines<T, size_policy>(1, minimum_elements);
+    static constexpr size_t static_size = lines * cache_line_size;
+
+  private:
+    using run_kernels = detail::slot_run<T, sizeof(cache_line_type)>;
+
+    std::array<cache_line_type, lines> m_lines; ///< inline, uninitialised
+
+    raw_slot<T>& slot(const size_t idx) {
+        return m_lines[idx % lines][(idx % static_size) / lines];
+    }
+    const raw_slot<T>& slot(const size_t idx) const {
+        return m_lines[idx % lines][(idx % static_size) / lines];
+    }
+
+  public:
+    /* user‑provided, so value‑initialising an owner leaves the ring alone
+     * rather than zeroing it */
+    fixed_false_sharing_optimized_buffer() noexcept {}
+
+    /* Element lifetime */
+    template <typename... Args>
+    T& construct(const size_t& idx, Args&&... args) {
+        return *std::construct_at(&slot(idx).value,
+                                  std::forward<Args>(args)...);
+    }
+    void destroy(const size_t& idx) { std::destroy_at(&slot(idx).value); }
+
+    /* Random access to constructed elements */
+    T& get(const size_t& idx) { return slot(idx).value; }
+    const T& get(const size_t& idx) const { return slot(idx).value; }
+    T& operator[](const size_t& idx) { return get(idx); }
+    const T& operator[](const size_t& idx) const { return get(idx); }
+
+    /// @brief Prefetch the line holding slot @p idx (see prefetch_line).
+    template <bool for_write = false> void prefetch(const size_t idx) const {
+        prefetch_line<for_write>(&slot(idx));
+    }
+    /// @brief Write every line once so its pages are mapped and the lines
+    /// cached; only while no slot is alive.
+    void touch() {
+        std::memset(static_cast<void*>(m_lines.data()), 0, sizeof(m_lines));
+    }
+
+    /* Bulk copies (see detail::slot_run) */
+    /// @brief Construct [@p first, @p first + @p count) from @p from.
+    void write_n(const size_t first, const T* from, const size_t count) {
+        detail::for_each_slot_run(
+            m_lines.data(), lines, cache_line_size, first, count,
+            [&](raw_slot<T>* slots, size_t n) {
+                run_kernels::scatter(slots, from, n);
+                from += n;
+            });
+    }
+    /// @brief Copy [@p first, @p first + @p count) out to @p to.
+    void copy_n(const size_t first, T* to, const size_t count) const {
+        detail::for_each_slot_run(
+            m_lines.data(), lines, cache_line_size, first, count,
+            [&](const raw_slot<T>* slots, size_t n) {
+                run_kernels::gather(slots, to, n);
+                to += n;
+            });
+    }
+    /// @brief Move [@p first, @p first + @p count) out to @p to and destroy.
+    void take_n(const size_t first, T* to, const size_t count) {
+        detail::for_each_slot_run(
+            m_lines.data(), lines, cache_line_size, first, count,
+            [&](raw_slot<T>* slots, size_t n) {
+                run_kernels::take(slots, to, n);
+                to += n;
+            });
+    }
+
+    /* Introspection */
+    static constexpr size_t number_of_cache_lines() { return lines; }
+    static constexpr size_t size() { return static_size; }
+};
+
 } // namespace hqlockfree
\ No newline at end of file
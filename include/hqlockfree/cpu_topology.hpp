@@ -0,0 +1,45 @@
+/**
+ * @file cpu_topology.hpp
+ * @brief CPU lists, topology and thread pinning, read from
+ *        `/sys/devices/system/cpu` – shared by the NUMA placement, the
+ *        interference probe and the benchmarks.
+ *
+ * Everything degrades to empty results (and pinning to a failed no‑op) where
+ * sysfs or the affinity calls are unavailable.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace hqlockfree {
+
+/// @brief Where one logical CPU sits.
+struct cpu_info {
+    int cpu;     ///< logical cpu number
+    int core;    ///< physical core id (unique within a package)
+    int package; ///< socket
+    int llc;     ///< last‑level cache domain (lowest cpu sharing it)
+};
+
+/// @brief Parse a sysfs cpu list such as "0-3,8,10-11".
+[[nodiscard]] std::vector<int> parse_cpu_list(const std::string& list);
+
+/// @return The list in the sysfs file @p path, empty if it cannot be read.
+[[nodiscard]] std::vector<int> read_cpu_list(const std::string& path);
+
+/// @return Every online CPU whose topology sysfs reports.
+[[nodiscard]] std::vector<cpu_info> read_cpu_topology();
+
+/// @return The CPUs the calling thread may run on.
+[[nodiscard]] std::vector<int> allowed_cpus();
+
+/// @brief Pin the calling thread to @p cpu; a negative cpu is a no‑op.
+/// @return `false` if the affinity could not be set.
+bool pin_current_thread(int cpu);
+
+/// @brief Let the calling thread run on any of @p cpus; empty is a no‑op.
+bool pin_current_thread(const std::vector<int>& cpus);
+
+} // namespace hqlockfree
\ No newline at end of file
@@ -1,9 +1,9 @@
 /**
  * @file daemon.hpp
- * @brief Tiny single‑threaded *callback dispatcher* that lives for the process
- *        lifetime.
+ * @brief Tiny *callback dispatcher* – one worker thread by default, or a few
+ *        sharing the callbacks – that lives for the process lifetime.
  *
- * A `hqlockfree::daemon` spawns one background thread that periodically walks a
+ * A `hqlockfree::daemon` spawns a background thread that periodically walks a
  * registry of user‑supplied *void() -> void* callbacks.  The class offers a
  * simple, contention‑free API:
  *
@@ -16,7 +16,53 @@
  * The dispatcher is thread‑safe:
  *  * **add_callback** / **remove_callback** may be invoked concurrently from
  *    any thread.
- *  * The callback map is guarded by an internal `std::mutex`.
+ *  * Each registry is *copy‑on‑write*: writers (serialised by a mutex) build a
+ *    new immutable snapshot and publish it with one atomic store; the worker
+ *    walks whichever snapshot it loaded at the start of a pass without taking
+ *    any lock.  A replaced snapshot is freed once the worker no longer walks
+ *    it (a single‑reader hazard pointer), which is also what lets
+ *    `remove_callback` promise that the callback has stopped running.
+ *
+ * ## Scheduling
+ * A callback registered without a period runs on every pass, as fast as the
+ * worker loops – what the fan‑out's min‑tail scan wants.  One with a period
+ * is kept in a @ref timer_wheel of microsecond ticks and runs when due, so
+ * housekeeping at millisecond cadence costs nothing in between:
+ *
+ * ```cpp
+ * d.schedule_every(10ms, [&] { fold_stats(); });
+ * d.schedule_after(2s, [&] { reclaim(); });         // once
+ * ```
+ *
+ * When nothing runs every pass, the worker waits for the next due time
+ * according to its @ref wait_policy: spinning (lowest latency), sleeping
+ * (no CPU) or sleeping until `spin_margin` before it and spinning the rest.
+ * A callback whose deadline is tighter than `spin_margin` turns sleeping
+ * into the latter, and runs that start later than their deadline are
+ * counted in `missed_deadlines()`.
+ *
+ * ## Workers
+ * A daemon may run several worker threads, each owning a *shard* of the
+ * callbacks with its own registry, wheel and wait, so hundreds of fan‑out
+ * scans need not queue behind one loop.  A callback is placed round‑robin,
+ * on an explicit shard (`add_callback_to`) or by hashing its owner
+ * (`shard_of`); workers can be pinned to CPUs:
+ *
+ * ```cpp
+ * hqlockfree::daemon d(4, {2, 3, 4, 5});
+ * d.add_callback_to(d.shard_of(this), [this] { scan(); });
+ * ```
+ *
+ * ## Profiling
+ * Built with `HQLOCKFREE_DAEMON_PROFILING` defined (CMake option of the same
+ * name), every run costs one `tsc_clock` read, at its end.  A run counts
+ * from the end of the one before it in the pass (or the pass's start), so
+ * its runtime includes the worker's own work since then – the wheel step
+ * and deadline check, with their `clock::now()` – though not an overrun
+ * hook.  Run times and the intervals between consecutive starts go into
+ * per‑callback histograms, read through `profile()`, and
+ * `set_overrun_hook()` reports runs longer than a threshold.  Without it
+ * neither exists and a run is a bare call.
  *
  * The helper `find_or_create_daemon()` gives the rest of the library a
  * convenient process‑wide singleton.  If you need multiple independent
@@ -25,12 +71,22 @@
 
 #pragma once
 
+#include "timer_wheel.hpp" // per‑callback periods
+
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+#include "sojourn_sampler.hpp" // sojourn_histogram
+#include "tsc_clock.hpp"       // tsc_clock
+#endif
+
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
-#include <unordered_map>
+#include <vector>
 
 namespace hqlockfree {
 
@@ -38,52 +94,242 @@ namespace hqlockfree {
 /// daemon::remove_callback.
 using callback_key_t = uint64_t;
 
+/// @brief How the daemon worker waits for the next due callback.
+enum class wait_policy {
+    spin,   ///< poll the clock: lowest latency, burns the core
+    sleep,  ///< block until the due time: no CPU, tens of µs of jitter
+    hybrid, ///< block until `spin_margin` before the due time, then spin
+};
+
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+/// @brief One callback's run‑time statistics, as `daemon::profile()` saw
+/// them (histogram quantiles: ~3% resolution).
+struct callback_profile {
+    callback_key_t key;
+    uint64_t runs;
+    uint64_t overruns; ///< runs longer than the overrun hook's threshold
+    std::chrono::nanoseconds runtime_p50, runtime_p99, runtime_max;
+    /// @brief Between consecutive starts.
+    std::chrono::nanoseconds interval_p50, interval_p99, interval_max;
+};
+#endif
+
 /**
  * @class daemon
  * @brief Background thread that repeatedly executes registered callbacks.
  */
 class daemon {
+  public:
+    using clock = std::chrono::steady_clock;
+
   private:
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    /// @brief Shared by every snapshot's copy of an entry; the histograms
+    /// are written by its worker only, and read by anyone.
+    struct callback_timing {
+        sojourn_histogram<> runtime;
+        sojourn_histogram<> interval;
+        uint64_t last_start = 0; ///< tsc; 0 = never ran
+        std::atomic<uint64_t> overruns{0};
+    };
+#endif
+
+    /// @brief One registered callback; a zero period means every pass.
+    struct callback_entry {
+        callback_key_t key;
+        std::function<void()> func;
+        std::chrono::nanoseconds period{0};
+        std::chrono::nanoseconds deadline{0}; ///< 0 = none
+        bool once = false;                    ///< remove after one run
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+        std::shared_ptr<callback_timing> timing;
+#endif
+    };
+    /// @brief Registered callbacks, in increasing (= registration) key order.
+    using registry = std::vector<callback_entry>;
+
+    /// @brief Worker state: what the wheel holds and what the loop needs.
+    struct worker_state {
+        timer_wheel<callback_key_t> wheel;
+        uint64_t generation = ~uint64_t(0); ///< last synchronised
+        callback_key_t scheduled = 0;       ///< keys below are in the wheel
+        bool every_pass = false;            ///< any entry without a period
+        bool tight = false;                 ///< any deadline below spin_margin
+        std::vector<callback_key_t> finished; ///< one‑shots that ran
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+        uint64_t tsc = 0; ///< a run's end, reused as the next run's start
+#endif
+    };
+
+    /// @brief One worker thread and the callbacks placed on it.
+    struct shard {
+        const int cpu; ///< pinned to, or -1
+        std::thread thread;
+        std::mutex mutex;                  ///< Serialises writers
+        std::mutex sleep_mutex;            ///< With wake, for a sleeping
+        std::condition_variable wake;      ///< worker to notice new entries
+        std::atomic<const registry*> current{new registry()}; ///< (owned)
+        std::atomic<const registry*> walking{nullptr}; ///< worker's snapshot
+        std::atomic<uint64_t> generation{0}; ///< bumped by every publish
+        /// @brief Replaced snapshots the worker may still be walking.
+        std::vector<std::unique_ptr<const registry>> retired;
+        uint64_t next_sequence = 0; ///< key generator, under `mutex`
+
+        explicit shard(int pinned_cpu) : cpu(pinned_cpu) {}
+        ~shard() { delete current.load(std::memory_order_relaxed); }
+    };
+
+    const wait_policy m_policy;
+    const std::chrono::nanoseconds m_spin_margin;
+    const clock::time_point m_epoch = clock::now(); ///< tick 0 of the wheels
+
     std::atomic<bool> m_should_run{true}; ///< Exit flag
-    std::thread m_thread;                 ///< Worker thread
-    std::mutex m_mutex;                   ///< Protects map below
+    std::atomic<uint64_t> m_missed_deadlines{0};
+    std::atomic<size_t> m_next_shard{0}; ///< round‑robin placement
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    std::atomic<uint64_t> m_overrun_ticks{0}; ///< tsc; 0 = no hook
+    std::mutex m_hook_mutex;
+    std::function<void(callback_key_t, std::chrono::nanoseconds)> m_hook;
+#endif
+    /// @brief Fixed at construction; a key's shard is `key % size()`.
+    std::vector<std::unique_ptr<shard>> m_shards;
+
+    uint64_t ticks(clock::time_point t) const;
+    static uint64_t ticks(std::chrono::nanoseconds d);
+    clock::time_point time_of(uint64_t tick) const;
+
+    /// @brief Announce and return the current snapshot (hazard pointer).
+    static const registry* enter(shard& s);
+    /// @brief Withdraw the announcement, waking writers waiting on it.
+    static void leave(shard& s);
+    /// @brief Schedule the timed entries of @p snapshot new to the wheel.
+    void synchronise(worker_state& state, const registry* snapshot,
+                     uint64_t now);
+    /// @brief One pass: every‑pass callbacks, then whatever the wheel has due.
+    void run_callbacks(shard& s, worker_state& state);
+    /// @brief Run one callback (and time it, when profiling).
+    void invoke(worker_state& state, const callback_entry& entry);
+    /// @brief Wait, per the policy, until the next due time or a new entry.
+    void wait_for_next(shard& s, const worker_state& state);
 
-    /// @brief Registered callbacks, keyed by monotonically increasing id.
-    std::unordered_map<callback_key_t, std::function<void()>> m_callbacks;
-    callback_key_t m_next_callback = 0; ///< id generator
+    /// @brief Register a callback on shard @p index, returning its key.
+    callback_key_t add(size_t index, callback_entry entry);
+    /// @brief Next shard for a callback placed without a hint.
+    size_t next_shard() {
+        return m_next_shard.fetch_add(1, std::memory_order_relaxed) %
+               m_shards.size();
+    }
+    /// @brief Is the caller one of the worker threads?
+    bool on_worker() const;
 
-    /// @brief Execute every callback *once*; called from the worker thread.
-    void run_callbacks();
+    /// @brief Swap in @p next and free the replaced snapshots the worker is
+    /// not walking – all of them, waiting if need be, if @p wait_for_worker.
+    /// The caller holds `s.mutex` in @p lock, released while waiting.
+    void publish(shard& s, std::unique_lock<std::mutex>& lock,
+                 const registry* next, bool wait_for_worker);
+    /// @brief The freeing half of publish(): drop the retired snapshots the
+    /// worker is not walking, waiting for the rest if @p wait_for_worker.
+    void reclaim(shard& s, std::unique_lock<std::mutex>& lock,
+                 bool wait_for_worker);
 
-    /// @brief Main event‑loop for the worker thread.
-    void run();
+    /// @brief Main event‑loop for a worker thread.
+    void run(shard& s);
+    /// @brief Stop and join the workers started so far.
+    void stop();
 
   public:
     /**
-     * @brief Construct and immediately launch the worker thread.
+     * @brief Construct and immediately launch one worker thread, which waits
+     *        between due callbacks per @p policy (see the file comment).
      */
-    daemon();
+    explicit daemon(wait_policy policy = wait_policy::spin,
+                    std::chrono::nanoseconds spin_margin =
+                        std::chrono::microseconds(100));
 
     /**
-     * @brief Signal the worker thread to stop and join() during destruction.
+     * @brief Construct with @p workers threads, worker *i* pinned to
+     *        `cpus[i]` where given and not negative.
+     * @throws std::invalid_argument if @p workers is 0; std::system_error if
+     *         a worker cannot be pinned.
+     */
+    explicit daemon(size_t workers, std::vector<int> cpus = {},
+                    wait_policy policy = wait_policy::spin,
+                    std::chrono::nanoseconds spin_margin =
+                        std::chrono::microseconds(100));
+
+    /**
+     * @brief Signal the worker threads to stop and join() during destruction.
      */
     ~daemon();
 
+    /// @return The number of worker threads (shards).
+    size_t workers() const { return m_shards.size(); }
+
+    /// @return The shard that hash placement assigns @p owner to, e.g. a
+    ///         fan‑out's `this`: stable for the owner's lifetime.
+    size_t shard_of(const void* owner) const;
+
     /**
-     * @brief Register @p func to be executed in the background thread.
+     * @brief Register @p func to be executed in a background thread: on
+     *        every pass, or every @p period once registered.  A run that
+     *        starts more than @p deadline after it was due counts as missed.
+     *        Callbacks are spread over the workers round‑robin.
      *
      * @return A unique opaque token that can later be passed to
      *         @ref remove_callback.
      */
-    [[nodiscard]] callback_key_t add_callback(std::function<void()> func);
+    [[nodiscard]] callback_key_t
+    add_callback(std::function<void()> func,
+                 std::chrono::nanoseconds period = {},
+                 std::chrono::nanoseconds deadline = {});
+
+    /// @brief add_callback() on the worker @p shard (< workers()).
+    [[nodiscard]] callback_key_t
+    add_callback_to(size_t shard, std::function<void()> func,
+                    std::chrono::nanoseconds period = {},
+                    std::chrono::nanoseconds deadline = {});
+
+    /**
+     * @brief Run @p func every @p period; see add_callback().
+     * @throws std::invalid_argument if @p period is not positive.
+     */
+    callback_key_t schedule_every(std::chrono::nanoseconds period,
+                                  std::function<void()> func,
+                                  std::chrono::nanoseconds deadline = {});
+
+    /// @brief Run @p func once, @p delay from now.  The key cancels it.
+    callback_key_t schedule_after(std::chrono::nanoseconds delay,
+                                  std::function<void()> func);
 
     /**
      * @brief Remove a previously registered callback.
      *
-     * Safe to call even if the callback is currently executing – the next
-     * iteration simply won’t see it.
+     * When this returns the callback is not running and never will again,
+     * so whatever it captured may be destroyed.  If it is executing, this
+     * waits for its worker's current pass to finish – except when called
+     * from a callback, i.e. on one of the workers, where waiting could
+     * deadlock; a callback only stops running there once its pass ends.
      */
     void remove_callback(callback_key_t key);
+
+    /// @return Runs that started later than their callback's deadline.
+    uint64_t missed_deadlines() const {
+        return m_missed_deadlines.load(std::memory_order_relaxed);
+    }
+
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    /// @return The statistics of every registered callback, by key.
+    std::vector<callback_profile> profile() const;
+
+    /**
+     * @brief Call @p hook(key, runtime) on the worker after every run longer
+     *        than @p threshold; an empty @p hook turns it off.  The hook
+     *        delays that worker's other callbacks, so keep it short.
+     */
+    void set_overrun_hook(
+        std::chrono::nanoseconds threshold,
+        std::function<void(callback_key_t, std::chrono::nanoseconds)> hook);
+#endif
 };
 
 /**
@@ -0,0 +1,47 @@
+/**
+ * @file interference.hpp
+ * @brief Run‑time check of the false‑sharing granularity of the machine, to
+ *        choose `HQLOCKFREE_DESTRUCTIVE_INTERFERENCE_SIZE` (cache_utils.hpp).
+ *
+ * Two sources are consulted:
+ *
+ * * **sysfs** – `coherency_line_size` of cpu0's L1 data cache, i.e. the line
+ *   the coherence protocol moves.
+ * * **Measurement** – two threads pinned to different physical cores (not
+ *   SMT siblings, which share L1) hammer counters 64, 128 and 256 bytes
+ *   apart.  The smallest separation that runs as fast as two counters a page
+ *   apart is the effective granularity; on parts whose spatial prefetcher
+ *   pulls lines in pairs that is 128 even though the line is 64.
+ *
+ * ```cpp
+ * auto report = hqlockfree::probe_interference();
+ * if (report.recommended != hqlockfree::destructive_interference_size)
+ *     warn("rebuild with -DHQLOCKFREE_DESTRUCTIVE_INTERFERENCE_SIZE=",
+ *          report.recommended);
+ * ```
+ *
+ * The measurement takes a few tens of milliseconds; call it from a tool or
+ * at start‑up, not on a hot path.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace hqlockfree {
+
+/// @brief What @ref probe_interference found.
+struct interference_report {
+    size_t coherency_line_size = 0; ///< from sysfs, 0 if unavailable
+    size_t measured = 0;    ///< from timing, 0 without two physical cores
+    size_t recommended = 0; ///< the larger of the two (or the default)
+
+    /// @brief ns per increment with the counters 64 / 128 / 256 bytes and
+    /// one page apart; 0 when not measured.
+    double ns_per_op[4] = {};
+};
+
+/// @brief Probe the machine; see the file comment.
+[[nodiscard]] interference_report probe_interference();
+
+} // namespace hqlockfree
\ No newline at end of file
@@ -0,0 +1,183 @@
+/**
+ * @file mmap_allocator.hpp
+ * @brief Allocator that maps ring storage straight from the kernel, with huge
+ *        pages, `mlock` and prefaulting, for `false_sharing_optimized_buffer`
+ *        and the queues built on it.
+ *
+ * A 64 MB ring in 4 KB pages spans 16k TLB entries and takes a page fault on
+ * the first touch of every page.  `mmap_allocator` trades that for:
+ *
+ * * **Huge pages** – `MAP_HUGETLB` from the reserved 2 MB pool when
+ *   available; otherwise a 2 MB‑aligned anonymous mapping advised with
+ *   `MADV_HUGEPAGE` so transparent huge pages can back it.
+ * * **Prefaulting** – `MAP_POPULATE` (or touching every page on the THP
+ *   path), so the faults happen in the constructor rather than on the hot
+ *   path.
+ * * **Locking** – `mlock`, so the pages are never swapped out.
+ * * **NUMA placement** – bind or interleave the ring across nodes before it
+ *   is faulted in (see numa.hpp).
+ *
+ * Every step degrades gracefully (no hugetlb pool, THP disabled,
+ * `RLIMIT_MEMLOCK` too small): the mapping is still returned and
+ * `info()` records what was actually obtained.  Only a failing base `mmap`
+ * throws `std::bad_alloc`.
+ *
+ * ```cpp
+ * hqlockfree::mmap_allocator<order> alloc({.huge_pages = true, .lock = true});
+ * hqlockfree::spsc_queue<order, cache_size_policy::pow2, hqlockfree::no_stats,
+ *                        hqlockfree::mmap_allocator<order>> q(0, 1 << 20,
+ *                                                             alloc);
+ * alloc.info().huge_tlb; // true if the hugetlb pool served it
+ * ```
+ */
+
+#pragma once
+
+#include "numa.hpp" // numa_placement
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace hqlockfree {
+
+/// @brief What an @ref mmap_allocator should try to obtain.
+struct mmap_options {
+    bool huge_pages = true; ///< MAP_HUGETLB, falling back to THP
+    bool populate = true;   ///< MAP_POPULATE (prefault)
+    bool lock = false;      ///< mlock the mapping
+    numa_placement numa;    ///< node binding / interleave (default: none)
+};
+
+/// @brief What the most recent allocation actually obtained.
+struct mmap_info {
+    bool huge_tlb = false;    ///< served from the hugetlb pool
+    bool transparent = false; ///< MADV_HUGEPAGE applied (THP eligible)
+    bool populated = false;   ///< pages faulted in at allocation
+    bool locked = false;      ///< mlock succeeded
+    bool numa_bound = false;  ///< mbind applied (else first‑touch fallback)
+};
+
+/**
+ * @tparam T Value type.
+ *
+ * @class mmap_allocator
+ * @brief Stateful allocator mapping each allocation with `mmap`.  Copies and
+ *        rebinds share the same @ref mmap_info.
+ */
+template <typename T> class mmap_allocator {
+  public:
+    using value_type = T;
+
+    static constexpr size_t huge_page_size = size_t(2) << 20;
+
+  private:
+    template <typename U> friend class mmap_allocator;
+
+    mmap_options m_options;
+    std::shared_ptr<mmap_info> m_info;
+
+    /// @brief Mapping length for @p bytes; must match in deallocate().
+    size_t mapping_length(size_t bytes) const {
+        const size_t page = m_options.huge_pages
+                                ? huge_page_size
+                                : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+
+    /// @brief Map @p length bytes aligned to a huge page for THP, trimming
+    /// the over‑allocation.
+    static void* map_aligned(size_t length, int flags) {
+        const size_t padded = length + huge_page_size;
+        void* raw =
+            mmap(nullptr, padded, PROT_READ | PROT_WRITE, flags & ~MAP_POPULATE,
+                 -1, 0);
+        if (raw == MAP_FAILED)
+            return MAP_FAILED;
+        const auto base = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned =
+            (base + huge_page_size - 1) & ~(uintptr_t(huge_page_size) - 1);
+        if (aligned != base)
+            munmap(raw, aligned - base);
+        if (const size_t tail = padded - (aligned - base) - length; tail != 0)
+            munmap(reinterpret_cast<void*>(aligned + length), tail);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    /// @brief Write one byte per small page so every fault happens now.
+    static void prefault(void* ptr, size_t length) {
+        const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        auto* bytes = static_cast<volatile char*>(ptr);
+        for (size_t offset = 0; offset < length; offset += page)
+            bytes[offset] = 0;
+    }
+
+  public:
+    explicit mmap_allocator(mmap_options options = {})
+        : m_options(options), m_info(std::make_shared<mmap_info>()) {}
+
+    template <typename U>
+    mmap_allocator(const mmap_allocator<U>& other)
+        : m_options(other.m_options), m_info(other.m_info) {}
+
+    /// @return What the most recent allocation (by any copy) obtained.
+    const mmap_info& info() const { return *m_info; }
+    const mmap_options& options() const { return m_options; }
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= huge_page_size);
+        const size_t length = mapping_length(n * sizeof(T));
+        /* with a NUMA policy the pages must not be faulted before mbind */
+        const bool place = m_options.numa.policy != numa_placement::kind::none;
+        const int base_flags =
+            MAP_PRIVATE | MAP_ANONYMOUS |
+            ((m_options.populate && !place) ? MAP_POPULATE : 0);
+        mmap_info info;
+        info.populated = m_options.populate;
+
+        void* ptr = MAP_FAILED;
+        if (m_options.huge_pages) {
+            ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                       base_flags | MAP_HUGETLB, -1, 0);
+            info.huge_tlb = (ptr != MAP_FAILED);
+            if (ptr == MAP_FAILED) {
+                ptr = map_aligned(length, base_flags);
+                info.transparent =
+                    (ptr != MAP_FAILED) &&
+                    (madvise(ptr, length, MADV_HUGEPAGE) == 0);
+            }
+        } else {
+            ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, base_flags, -1,
+                       0);
+        }
+        if (ptr == MAP_FAILED)
+            throw std::bad_alloc();
+
+        if (place)
+            info.numa_bound = apply_numa_placement(ptr, length, m_options.numa);
+        /* populate after advising / binding so the faults honour both */
+        const bool transparent_path = m_options.huge_pages && !info.huge_tlb;
+        if (m_options.populate && (place || transparent_path))
+            prefault(ptr, length);
+
+        if (m_options.lock)
+            info.locked = (mlock(ptr, length) == 0);
+        *m_info = info;
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        munmap(ptr, mapping_length(n * sizeof(T)));
+    }
+
+    template <typename U>
+    bool operator==(const mmap_allocator<U>& other) const {
+        return m_info == other.m_info;
+    }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
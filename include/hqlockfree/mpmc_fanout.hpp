@@ -22,26 +22,41 @@
 
 #include "cache_utils.hpp"   // false_sharing_optimized_buffer & friends
 #include "daemon.hpp"        // background callback engine
+#include "queue_stats.hpp"   // no_stats & queue_stats
 #include "write_confirm.hpp" // write reservation / commit helper
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace hqlockfree {
 
 /**
  * @tparam T            Element type.
- * @tparam size_policy  Cache‑line packing policy; defaults to `pow2`.
+ * @tparam ring_buffer  Ring storage: `false_sharing_optimized_buffer` (sized at
+ *                      construction) or `fixed_false_sharing_optimized_buffer`
+ *                      (sized at compile time).
+ * @tparam stats_policy Statistics hooks, shared by producers and every
+ *                      subscription (default: `no_stats`, zero cost).
+ * @tparam prefetch_policy Prefetching ahead of push and pop, one instance
+ *                      per subscription (default: `no_prefetch`, zero cost).
  *
- * @class mpmc_fanout
+ * @class basic_mpmc_fanout
  * @brief Lock‑free fan‑out queue with *N* producers and *M* independent
  *        consumers.
+ *
+ * Use through the @ref mpmc_fanout and @ref fixed_mpmc_fanout aliases.
  */
-template <typename T, cache_size_policy size_policy = cache_size_policy::pow2>
-class mpmc_fanout {
+template <typename T, typename ring_buffer, typename stats_policy = no_stats,
+          typename prefetch_policy = no_prefetch>
+class basic_mpmc_fanout {
   public:
+    using buffer_type = ring_buffer;
+
     /**
      * @class subscription_handle
      * @brief Per‑consumer cursor into the shared ring buffer.
@@ -51,24 +66,29 @@ class mpmc_fanout {
      */
     class subscription_handle {
       private:
-        const false_sharing_optimized_buffer<T, size_policy>&
-            m_buffer;                                    ///< shared storage
+        const buffer_type& m_buffer;                     ///< shared storage
         const write_confirm& m_write_confirmer;          ///< global read head
+        stats_policy& m_stats;                           ///< owner's stats
         cache_padded<std::atomic<std::uint64_t>> m_tail; ///< consumer cursor
         bool m_subscribed = true;
+        [[no_unique_address]] prefetch_policy m_prefetch; ///< per reader
 
       public:
         explicit subscription_handle(
-            const false_sharing_optimized_buffer<T, size_policy>& buffer,
-            const write_confirm& write_confirmer)
+            const buffer_type& buffer, const write_confirm& write_confirmer,
+            stats_policy& stats)
             : m_buffer(buffer), m_write_confirmer(write_confirmer),
-              m_tail(m_write_confirmer.get_read_index()) {}
+              m_stats(stats), m_tail(m_write_confirmer.get_read_index()) {}
 
         /** @brief Current read cursor. */
         uint64_t get_tail() const {
             return m_tail.load(std::memory_order_relaxed);
         }
 
+        /// @return This reader's prefetch policy; set it from the
+        ///         consuming thread.
+        prefetch_policy& prefetch() { return m_prefetch; }
+
         /** @brief Is this subscriber active. */
         bool subscribed() const { return m_subscribed; }
 
@@ -85,19 +105,45 @@ class mpmc_fanout {
                 return false;
             const uint64_t read_head = m_write_confirmer.get_read_index();
             const uint64_t tail = m_tail.load(std::memory_order_relaxed);
-            if (read_head <= tail)
+            if (read_head <= tail) {
+                m_stats.on_empty_pop();
                 return false;
+            }
+            m_prefetch.template ahead<false>(m_buffer, tail);
             value = m_buffer[tail];
+            m_stats.on_pop(tail);
             m_tail.store(tail + 1, std::memory_order_release);
             return true;
         }
+
+        /**
+         * @brief Copy up to @p max elements into @p values with one cursor
+         *        update.
+         * @return The number popped, 0 if no new data.
+         */
+        size_t pop_n(T* values, size_t max) {
+            if (!subscribed())
+                return 0;
+            const uint64_t read_head = m_write_confirmer.get_read_index();
+            const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+            if (read_head <= tail) {
+                m_stats.on_empty_pop();
+                return 0;
+            }
+            const size_t n = std::min<uint64_t>(read_head - tail, max);
+            m_buffer.copy_n(tail, values, n);
+            for (uint64_t k = 0; k < n; k++)
+                m_stats.on_pop(tail + k);
+            m_tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
     };
 
   private:
     /* ------------------------------------------------------------------
      *  Shared state
      * ----------------------------------------------------------------*/
-    false_sharing_optimized_buffer<T, size_policy> m_buffer;
+    buffer_type m_buffer;
     write_confirm m_write_confirmer;
 
     cache_padded<std::atomic<uint64_t>> m_min_tail = 0; ///< min(tail_i)
@@ -105,16 +151,21 @@ class mpmc_fanout {
     const size_t m_capacity;             ///< total usable slots
     const size_t m_free_capacity_needed; ///< == capacity‑1
 
+    [[no_unique_address]] stats_policy m_stats; ///< see queue_stats.hpp
+    [[no_unique_address]] prefetch_policy m_prefetch; ///< producers'
+
     /* subscriptions ----------------------------------------------------*/
     std::vector<std::shared_ptr<subscription_handle>> m_subscriptions;
     std::mutex m_subscription_mutex;
 
     /* daemon callback --------------------------------------------------*/
+    daemon& m_daemon; ///< runs update_min_tail(); outlives the fan‑out
     callback_key_t m_callback_key;
 
     /** @brief Re‑compute global `m_min_tail` (called from background daemon).
      */
     void update_min_tail() {
+        m_stats.on_scan_begin();
         std::lock_guard<std::mutex> lock(m_subscription_mutex);
         uint64_t min_tail = m_write_confirmer.get_read_index();
         for (auto it = m_subscriptions.begin(); it != m_subscriptions.end();) {
@@ -127,44 +178,81 @@ class mpmc_fanout {
             }
         }
         m_min_tail.store(min_tail, std::memory_order_release);
+        m_stats.on_scan_end();
     }
 
     /* Internal helpers --------------------------------------------------*/
-    /// @brief Reserve one slot for the calling producer – MAY spin if full.
-    uint64_t get_free_index() {
-        uint64_t index = m_write_confirmer.get_write_index();
-        while ((index - m_min_tail.load(std::memory_order_relaxed)) >=
-               m_free_capacity_needed) {
+    /// @brief capacity‑1; a constant when the buffer is sized at compile time.
+    size_t free_capacity_needed() const {
+        if constexpr (ring_buffer::static_size != 0)
+            return ring_buffer::static_size - 1UL;
+        else
+            return m_free_capacity_needed;
+    }
+    /// @brief Reserve @p count (< capacity) consecutive slots for the
+    /// calling producer – MAY spin until the last of them is free.
+    uint64_t get_free_index(uint64_t count = 1) {
+        uint64_t index = m_write_confirmer.get_write_index(count);
+        uint64_t min_tail;
+        while ((index + count - 1 -
+                (min_tail = m_min_tail.load(std::memory_order_relaxed))) >=
+               free_capacity_needed()) {
             /* busy wait */
+            m_stats.on_full_wait();
         }
+        m_stats.on_reserve(index - min_tail + count);
         return index;
     }
 
-    /// @brief Mark @p written_index as the newest committed element.
-    void update_read_head(uint64_t written_index) {
-        m_write_confirmer.confirm_write(written_index);
+    /// @brief Commit the @p count elements reserved at @p written_index.
+    void update_read_head(uint64_t written_index, uint64_t count = 1) {
+        m_write_confirmer.confirm_write(written_index, count, m_stats);
     }
 
   public:
     /**
-     * @brief Construct a buffer with at least @p min_cache_lines lines *or*
-     *        @p min_elements elements.
+     * @brief Construct the ring from @p args: for @ref mpmc_fanout at least
+     *        `min_cache_lines` lines *or* `min_elements` elements stored
+     *        through `alloc`; for @ref fixed_mpmc_fanout nothing.  The
+     *        min‑tail scan runs on the process‑wide daemon.
      */
-    explicit mpmc_fanout(size_t min_cache_lines, size_t min_elements = 0)
-        : m_buffer(min_cache_lines, min_elements), m_capacity(m_buffer.size()),
-          m_free_capacity_needed(m_capacity - 1UL) {
-        m_callback_key = find_or_create_daemon()->add_callback(
-            [&]() { this->update_min_tail(); });
+    template <typename... buffer_args>
+    explicit basic_mpmc_fanout(buffer_args&&... args)
+        : basic_mpmc_fanout(*find_or_create_daemon(),
+                            std::forward<buffer_args>(args)...) {}
+
+    /**
+     * @brief As above, but scan on @p maintenance – e.g. a dedicated, pinned
+     *        daemon for a latency‑critical bus, so that it does not wait
+     *        behind the scans of bulk fan‑outs.  @p maintenance must outlive
+     *        the fan‑out.
+     */
+    template <typename... buffer_args>
+    explicit basic_mpmc_fanout(daemon& maintenance, buffer_args&&... args)
+        : m_buffer(std::forward<buffer_args>(args)...),
+          m_capacity(m_buffer.size()),
+          m_free_capacity_needed(m_capacity - 1UL), m_daemon(maintenance) {
+        m_stats.on_attach(m_capacity);
+        m_callback_key = m_daemon.add_callback_to(
+            m_daemon.shard_of(this), [&]() { this->update_min_tail(); });
     }
 
-    /** Cancel daemon callback. */
-    ~mpmc_fanout() { find_or_create_daemon()->remove_callback(m_callback_key); }
+    /** Cancel daemon callback and destroy the elements still in the ring. */
+    ~basic_mpmc_fanout() {
+        m_daemon.remove_callback(m_callback_key);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const uint64_t head = m_write_confirmer.get_read_index();
+            for (uint64_t index = (head > capacity()) ? head - capacity() : 0;
+                 index < head; index++)
+                m_buffer.destroy(index);
+        }
+    }
 
     /* Non‑movable / non‑copyable ---------------------------------------*/
-    mpmc_fanout(const mpmc_fanout&) = delete;
-    mpmc_fanout& operator=(const mpmc_fanout&) = delete;
-    mpmc_fanout(mpmc_fanout&&) = delete;
-    mpmc_fanout& operator=(mpmc_fanout&&) = delete;
+    basic_mpmc_fanout(const basic_mpmc_fanout&) = delete;
+    basic_mpmc_fanout& operator=(const basic_mpmc_fanout&) = delete;
+    basic_mpmc_fanout(basic_mpmc_fanout&&) = delete;
+    basic_mpmc_fanout& operator=(basic_mpmc_fanout&&) = delete;
 
     /* ------------------------------------------------------------------
      *  Consumer API
@@ -173,7 +261,8 @@ class mpmc_fanout {
     [[nodiscard]] std::shared_ptr<subscription_handle> subscribe() {
         std::lock_guard<std::mutex> lock(m_subscription_mutex);
         return m_subscriptions.emplace_back(
-            std::make_shared<subscription_handle>(m_buffer, m_write_confirmer));
+            std::make_shared<subscription_handle>(m_buffer, m_write_confirmer,
+                                                  m_stats));
     }
 
     /* ------------------------------------------------------------------
@@ -185,21 +274,134 @@ class mpmc_fanout {
         return m_write_confirmer.get_read_index() - current_tail;
     }
     /// @return The ring size.
-    size_t capacity() const { return m_capacity; }
+    size_t capacity() const {
+        if constexpr (ring_buffer::static_size != 0)
+            return ring_buffer::static_size;
+        else
+            return m_capacity;
+    }
+    /// @return The producers' prefetch policy (e.g. `prefetch().distance`);
+    ///         subscriptions have their own.
+    const prefetch_policy& prefetch() const { return m_prefetch; }
+    prefetch_policy& prefetch() { return m_prefetch; }
+    /**
+     * @brief Warm the queue up before traffic starts: write every line of
+     *        the ring (faulting its pages in), run @p cycles push / pop
+     *        pairs of @p sample through the producer, subscription and
+     *        daemon scan paths, then rewind the cursors to 0 and reset the
+     *        stats if they support it.  Call before anything is pushed or
+     *        anyone subscribes.
+     */
+    void warm_up(size_t cycles = 1024, const T& sample = T()) {
+        m_buffer.touch();
+        T out = sample;
+        {
+            auto reader = subscribe();
+            for (size_t i = 0; i < cycles; i++) {
+                push(sample);
+                reader->pop(out);
+                update_min_tail(); // no waiting on the daemon's period
+            }
+            reader->unsubscribe();
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const uint64_t head = m_write_confirmer.get_read_index();
+            for (uint64_t index = (head > capacity()) ? head - capacity() : 0;
+                 index < head; index++)
+                m_buffer.destroy(index);
+        }
+        /* under the lock, so a concurrent scan sees old or new cursors */
+        std::lock_guard<std::mutex> lock(m_subscription_mutex);
+        m_write_confirmer.reset();
+        m_min_tail.store(0, std::memory_order_release);
+        if constexpr (requires { m_stats.reset(); })
+            m_stats.reset();
+    }
+    /// @return The statistics policy instance (e.g. `stats().snapshot()`).
+    const stats_policy& stats() const { return m_stats; }
+    stats_policy& stats() { return m_stats; }
 
     /* ------------------------------------------------------------------
      *  Producer API
      * ----------------------------------------------------------------*/
-    void push(const T& value) {
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    /// @brief Construct the element in place from @p args.  Subscribers copy
+    /// elements out, so each one lives until its slot is reused.
+    template <typename... Args> void emplace(Args&&... args) {
         uint64_t index = get_free_index();
-        m_buffer[index] = value;
+        m_stats.on_push(index);
+        m_prefetch.template ahead<true>(m_buffer, index);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            /* every subscriber is past index - capacity, see get_free_index */
+            if (index >= capacity())
+                m_buffer.destroy(index);
+        }
+        m_buffer.construct(index, std::forward<Args>(args)...);
         update_read_head(index);
     }
-    void push(T&& value) {
-        uint64_t index = get_free_index();
-        m_buffer[index] = std::move(value);
-        update_read_head(index);
+
+    /**
+     * @brief Push the @p count elements at @p values in order, in chunks of
+     *        at most capacity‑1, each reserved and published in one step –
+     *        MAY spin while the ring is full.  Trivially copyable elements
+     *        are copied with `memcpy` kernels rather than one by one.
+     */
+    void push_n(const T* values, size_t count) {
+        while (count != 0) {
+            const uint64_t n =
+                std::min<uint64_t>(count, free_capacity_needed());
+            const uint64_t index = get_free_index(n);
+            for (uint64_t k = 0; k < n; k++) {
+                m_stats.on_push(index + k);
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    if (index + k >= capacity())
+                        m_buffer.destroy(index + k);
+                }
+            }
+            m_buffer.write_n(index, values, n);
+            update_read_head(index, n);
+            values += n;
+            count -= n;
+        }
     }
 };
 
+/**
+ * @tparam T            Element type.
+ * @tparam size_policy  Cache‑line packing policy; defaults to `pow2`.
+ * @tparam stats_policy Statistics hooks (default: `no_stats`, zero cost).
+ * @tparam allocator    Ring storage (e.g. `mmap_allocator` for huge pages).
+ * @tparam interference_size Slot granularity for elements larger than a
+ *                      cache line (64, or 128 for adjacent‑line pairs).
+ * @tparam prefetch_policy Prefetching (default: `no_prefetch`, zero cost).
+ *
+ * @brief Fan‑out queue sized at construction:
+ *        `mpmc_fanout<T> q(min_cache_lines, min_elements = 0, alloc = {})`.
+ */
+template <typename T, cache_size_policy size_policy = cache_size_policy::pow2,
+          typename stats_policy = no_stats,
+          typename allocator = std::allocator<T>,
+          size_t interference_size = destructive_interference_size,
+          typename prefetch_policy = no_prefetch>
+using mpmc_fanout = basic_mpmc_fanout<
+    T,
+    false_sharing_optimized_buffer<T, size_policy, allocator,
+                                   interference_size>,
+    stats_policy, prefetch_policy>;
+
+/// @brief Fan‑out queue holding at least @p capacity elements inline, with
+/// all index math constant‑folded.
+template <typename T, size_t capacity,
+          cache_size_policy size_policy = cache_size_policy::pow2,
+          typename stats_policy = no_stats,
+          size_t interference_size = destructive_interference_size,
+          typename prefetch_policy = no_prefetch>
+using fixed_mpmc_fanout = basic_mpmc_fanout<
+    T,
+    fixed_false_sharing_optimized_buffer<T, size_policy, capacity,
+                                         interference_size>,
+    stats_policy, prefetch_policy>;
+
 } // namespace hqlockfree
\ No newline at end of file
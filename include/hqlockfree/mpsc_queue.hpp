@@ -18,23 +18,32 @@
 #pragma once
 
 #include "cache_utils.hpp"
+#include "queue_stats.hpp"
 #include "write_confirm.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace hqlockfree {
 
 /* -----------------------------------------------------------------------
  *  queue – lock‑free MPSC ring buffer
+ *
+ *  `ring_buffer` is the ring storage; use through the mpsc_queue (sized at
+ *  construction) and fixed_mpsc_queue (sized at compile time) aliases below.
  * ---------------------------------------------------------------------*/
 
-template <typename T, cache_size_policy size_policy = cache_size_policy::pow2>
-class mpsc_queue {
+template <typename T, typename ring_buffer, typename stats_policy = no_stats,
+          typename prefetch_policy = no_prefetch>
+class basic_mpsc_queue {
   private:
     /* State -------------------------------------------------------------*/
-    false_sharing_optimized_buffer<T, size_policy> m_buffer;
+    ring_buffer m_buffer;
 
     write_confirm m_write_confirm;
 
@@ -43,40 +52,71 @@ class mpsc_queue {
     const size_t m_capacity;             ///< total usable slots
     const size_t m_free_capacity_needed; ///< == capacity‑1
 
+    [[no_unique_address]] stats_policy m_stats; ///< see queue_stats.hpp
+    [[no_unique_address]] prefetch_policy m_prefetch; ///< see cache_utils.hpp
+
     /* Internal helpers --------------------------------------------------*/
-    /// @brief Reserve one slot for the calling producer – MAY spin if full.
-    uint64_t get_free_index() {
-        uint64_t index = m_write_confirm.get_write_index();
-        while ((index - m_tail.load(std::memory_order_relaxed)) >=
-               m_free_capacity_needed) {
+    /// @brief capacity‑1; a constant when the buffer is sized at compile time.
+    size_t free_capacity_needed() const {
+        if constexpr (ring_buffer::static_size != 0)
+            return ring_buffer::static_size - 1UL;
+        else
+            return m_free_capacity_needed;
+    }
+    /// @brief Reserve @p count (< capacity) consecutive slots for the
+    /// calling producer – MAY spin until the last of them is free.
+    uint64_t get_free_index(uint64_t count = 1) {
+        uint64_t index = m_write_confirm.get_write_index(count);
+        uint64_t tail;
+        while ((index + count - 1 -
+                (tail = m_tail.load(std::memory_order_relaxed))) >=
+               free_capacity_needed()) {
             /* busy wait */
+            m_stats.on_full_wait();
         }
+        m_stats.on_reserve(index - tail + count);
         return index;
     }
 
-    /// @brief Mark @p written_index as the newest committed element.
-    void update_read_head(uint64_t written_index) {
-        m_write_confirm.confirm_write(written_index);
+    /// @brief Commit the @p count elements reserved at @p written_index.
+    void update_read_head(uint64_t written_index, uint64_t count = 1) {
+        m_write_confirm.confirm_write(written_index, count, m_stats);
     }
 
   public:
     /**
-     * @brief Create a queue with at least @p min_cache_lines cache lines, or
-     *        enough capacity to hold @p min_elements, whichever results in the
-     *        larger buffer.
+     * @brief Create the ring from @p args.  For `mpsc_queue`: at least
+     *        `min_cache_lines` cache lines, or enough capacity to hold
+     *        `min_elements`, whichever results in the larger buffer, obtained
+     *        from `alloc` (e.g. `mmap_allocator`).  For `fixed_mpsc_queue`:
+     *        nothing.
      *
      * @note For an MPSC ring the usable capacity is *capacity‑1*; one slot is
      *       intentionally left vacant to distinguish full vs. empty states.
      */
-    explicit mpsc_queue(size_t min_cache_lines, size_t min_elements = 0)
-        : m_buffer(min_cache_lines, min_elements), m_capacity(m_buffer.size()),
-          m_free_capacity_needed(m_capacity - 1UL) {}
+    template <typename... buffer_args>
+    explicit basic_mpsc_queue(buffer_args&&... args)
+        : m_buffer(std::forward<buffer_args>(args)...),
+          m_capacity(m_buffer.size()),
+          m_free_capacity_needed(m_capacity - 1UL) {
+        m_stats.on_attach(m_capacity);
+    }
+
+    /// @brief Destroy the elements still queued (every push must be done).
+    ~basic_mpsc_queue() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const uint64_t head = m_write_confirm.get_read_index();
+            for (uint64_t index = m_tail.load(std::memory_order_relaxed);
+                 index < head; index++)
+                m_buffer.destroy(index);
+        }
+    }
 
     /* Non‑movable / non‑copyable ---------------------------------------*/
-    mpsc_queue(const mpsc_queue&) = delete;
-    mpsc_queue& operator=(const mpsc_queue&) = delete;
-    mpsc_queue(mpsc_queue&&) = delete;
-    mpsc_queue& operator=(mpsc_queue&&) = delete;
+    basic_mpsc_queue(const basic_mpsc_queue&) = delete;
+    basic_mpsc_queue& operator=(const basic_mpsc_queue&) = delete;
+    basic_mpsc_queue(basic_mpsc_queue&&) = delete;
+    basic_mpsc_queue& operator=(basic_mpsc_queue&&) = delete;
 
     /* Introspection -----------------------------------------------------*/
     /// @return The current number of elements available to the consumer.
@@ -85,30 +125,138 @@ class mpsc_queue {
         return m_write_confirm.get_read_index() - current_tail;
     }
     /// @return The ring size.
-    size_t capacity() const { return m_capacity; }
+    size_t capacity() const {
+        if constexpr (ring_buffer::static_size != 0)
+            return ring_buffer::static_size;
+        else
+            return m_capacity;
+    }
+    /// @return The prefetch policy instance (e.g. `prefetch().distance`).
+    const prefetch_policy& prefetch() const { return m_prefetch; }
+    prefetch_policy& prefetch() { return m_prefetch; }
+    /**
+     * @brief Warm the queue up before traffic starts: write every line of
+     *        the ring (faulting its pages in), run @p cycles push / pop
+     *        pairs of @p sample through the hot paths, then rewind the
+     *        cursors to 0 and reset the stats if they support it.  Call on
+     *        an empty queue, before the producers and consumer start.
+     */
+    void warm_up(size_t cycles = 1024, const T& sample = T()) {
+        m_buffer.touch();
+        T out = sample;
+        for (size_t i = 0; i < cycles; i++) {
+            push(sample);
+            pop(out);
+        }
+        m_write_confirm.reset();
+        m_tail.store(0, std::memory_order_release);
+        if constexpr (requires { m_stats.reset(); })
+            m_stats.reset();
+    }
+    /**
+     * @brief Drop the slots reserved by producers that never confirmed them,
+     *        e.g. when the queue is reopened from a file after a crash (see
+     *        persistent_queue.hpp).  Only while no producer is running.
+     */
+    void abandon_reservations() { m_write_confirm.abandon_reservations(); }
+    /// @return The statistics policy instance (e.g. `stats().snapshot()`).
+    const stats_policy& stats() const { return m_stats; }
+    stats_policy& stats() { return m_stats; }
 
     /* Producer API ------------------------------------------------------*/
-    void push(const T& value) {
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    /// @brief Construct the element in place from @p args.
+    template <typename... Args> void emplace(Args&&... args) {
         uint64_t index = get_free_index();
-        m_buffer[index] = value;
+        m_stats.on_push(index);
+        m_prefetch.template ahead<true>(m_buffer, index);
+        m_buffer.construct(index, std::forward<Args>(args)...);
         update_read_head(index);
     }
-    void push(T&& value) {
-        uint64_t index = get_free_index();
-        m_buffer[index] = std::move(value);
-        update_read_head(index);
+
+    /**
+     * @brief Push the @p count elements at @p values in order, in chunks of
+     *        at most capacity‑1, each reserved and published in one step –
+     *        MAY spin while the ring is full.  Trivially copyable elements
+     *        are copied with `memcpy` kernels rather than one by one.
+     */
+    void push_n(const T* values, size_t count) {
+        while (count != 0) {
+            const uint64_t n =
+                std::min<uint64_t>(count, free_capacity_needed());
+            const uint64_t index = get_free_index(n);
+            for (uint64_t k = 0; k < n; k++)
+                m_stats.on_push(index + k);
+            m_buffer.write_n(index, values, n);
+            update_read_head(index, n);
+            values += n;
+            count -= n;
+        }
     }
 
     /* Consumer API ------------------------------------------------------*/
     bool pop(T& value) {
         const uint64_t read_head = m_write_confirm.get_read_index();
         const uint64_t tail = m_tail.load(std::memory_order_relaxed);
-        if (read_head <= tail)
+        if (read_head <= tail) {
+            m_stats.on_empty_pop();
             return false;
+        }
+        m_prefetch.template ahead<false>(m_buffer, tail);
         value = std::move(m_buffer[tail]);
+        m_buffer.destroy(tail);
+        m_stats.on_pop(tail);
         m_tail.store(tail + 1, std::memory_order_release);
         return true;
     }
+
+    /**
+     * @brief Pop up to @p max committed elements into @p values with one
+     *        cursor update.
+     * @return The number popped, 0 if nothing was committed.
+     */
+    size_t pop_n(T* values, size_t max) {
+        const uint64_t read_head = m_write_confirm.get_read_index();
+        const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (read_head <= tail) {
+            m_stats.on_empty_pop();
+            return 0;
+        }
+        const size_t n = std::min<uint64_t>(read_head - tail, max);
+        m_buffer.take_n(tail, values, n);
+        for (uint64_t k = 0; k < n; k++)
+            m_stats.on_pop(tail + k);
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
 };
 
+/// @brief MPSC queue sized at construction:
+/// `mpsc_queue<T> q(min_cache_lines, min_elements = 0, alloc = {})`.
+template <typename T, cache_size_policy size_policy = cache_size_policy::pow2,
+          typename stats_policy = no_stats,
+          typename allocator = std::allocator<T>,
+          size_t interference_size = destructive_interference_size,
+          typename prefetch_policy = no_prefetch>
+using mpsc_queue = basic_mpsc_queue<
+    T,
+    false_sharing_optimized_buffer<T, size_policy, allocator,
+                                   interference_size>,
+    stats_policy, prefetch_policy>;
+
+/// @brief MPSC queue holding at least @p capacity elements inline, with all
+/// index math constant‑folded: `static fixed_mpsc_queue<T, 4096> q;`.
+template <typename T, size_t capacity,
+          cache_size_policy size_policy = cache_size_policy::pow2,
+          typename stats_policy = no_stats,
+          size_t interference_size = destructive_interference_size,
+          typename prefetch_policy = no_prefetch>
+using fixed_mpsc_queue = basic_mpsc_queue<
+    T,
+    fixed_false_sharing_optimized_buffer<T, size_policy, capacity,
+                                         interference_size>,
+    stats_policy, prefetch_policy>;
+
 } // namespace hqlockfree
\ No newline at end of file
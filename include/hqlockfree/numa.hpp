@@ -0,0 +1,144 @@
+/**
+ * @file numa.hpp
+ * @brief NUMA placement for ring storage and queue control state.
+ *
+ * On a multi‑socket machine memory lives on the node of the thread that first
+ * touched it, so a ring built by the main thread can sit a socket away from
+ * the consumer that polls it.  This header lets the caller choose instead:
+ *
+ * * **Ring data** – set `mmap_options::numa` on an `mmap_allocator`
+ *   (mmap_allocator.hpp) to bind the buffer to one node (typically the
+ *   consumer's) or interleave it across several.
+ * * **Cursors** – `m_head`, `m_tail` and the `write_confirm` heads live inside
+ *   the queue object.  `numa_placed<Queue>` constructs the queue in memory
+ *   bound to a node.  Pages are the unit of placement, so every cursor of one
+ *   queue shares that node; choose the node of the thread that polls hardest
+ *   (the consumer for spsc / mpsc).
+ *
+ * Placement uses the `mbind` system call directly (no libnuma).  Where it is
+ * unavailable (old kernels, seccomp filters) the pages are *first‑touched*
+ * from a thread pinned to the target node instead, which gives the same
+ * result under the default local‑allocation policy.
+ *
+ * Everything degrades to a no‑op on single‑node machines.
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace hqlockfree {
+
+/// @brief Where a range of memory should live.
+struct numa_placement {
+    enum class kind {
+        none,      ///< leave it to the kernel (first touch)
+        bind,      ///< the single node in `nodes`
+        interleave ///< round‑robin across `nodes`, page by page
+    };
+
+    kind policy = kind::none;
+    uint64_t nodes = 0; ///< bit mask of node ids
+
+    /// @throws std::invalid_argument if @p node is outside [0, 64), the
+    ///         ids a `nodes` mask can hold.
+    static numa_placement on_node(int node) {
+        if (node < 0 || node >= 64)
+            throw std::invalid_argument(
+                "hqlockfree::numa_placement: no node " +
+                std::to_string(node) + " in a 64‑bit mask");
+        return {kind::bind, uint64_t(1) << node};
+    }
+    static numa_placement interleaved(uint64_t nodes);
+};
+
+/// @return Number of online NUMA nodes (1 if the kernel reports none).
+[[nodiscard]] int numa_node_count();
+
+/// @return Mask of every online node.
+[[nodiscard]] uint64_t numa_online_nodes();
+
+/// @return Node that @p cpu belongs to, or 0 if unknown.
+[[nodiscard]] int numa_node_of_cpu(int cpu);
+
+/// @return Node the calling thread is currently running on.
+[[nodiscard]] int current_numa_node();
+
+/// @return Node backing the (faulted‑in) page at @p address, or -1 if the
+/// kernel cannot tell.
+[[nodiscard]] int numa_node_of(const void* address);
+
+/**
+ * @brief Apply @p where to the page‑aligned range [@p address,
+ *        @p address + @p length), moving pages already faulted in.
+ *
+ * Falls back to @ref first_touch when `mbind` is unavailable.
+ * @return `true` if `mbind` took effect, `false` if the fallback ran or
+ *         @p where is `none`.
+ */
+bool apply_numa_placement(void* address, size_t length,
+                          const numa_placement& where);
+
+/**
+ * @brief Fault in every page of the range from threads pinned to the nodes
+ *        of @p where – the fallback when `mbind` is unavailable.
+ */
+void first_touch(void* address, size_t length, const numa_placement& where);
+
+inline numa_placement numa_placement::interleaved(uint64_t nodes) {
+    return {kind::interleave, nodes ? nodes : numa_online_nodes()};
+}
+
+/**
+ * @tparam Q Object type (typically a queue).
+ *
+ * @class numa_placed
+ * @brief Owns a @p Q constructed in its own page‑aligned mapping placed per
+ *        a @ref numa_placement, so its cursors live on the chosen node.
+ */
+template <typename Q> class numa_placed {
+  private:
+    Q* m_object = nullptr;
+    size_t m_length = 0;
+
+  public:
+    template <typename... Args>
+    explicit numa_placed(const numa_placement& where, Args&&... args) {
+        static_assert(alignof(Q) <= 4096);
+        const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        m_length = (sizeof(Q) + page - 1) / page * page;
+        void* memory = mmap(nullptr, m_length, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+            throw std::bad_alloc();
+        apply_numa_placement(memory, m_length, where);
+        try {
+            m_object = new (memory) Q(std::forward<Args>(args)...);
+        } catch (...) {
+            munmap(memory, m_length);
+            throw;
+        }
+    }
+
+    ~numa_placed() {
+        m_object->~Q();
+        munmap(m_object, m_length);
+    }
+
+    numa_placed(const numa_placed&) = delete;
+    numa_placed& operator=(const numa_placed&) = delete;
+
+    Q* get() const { return m_object; }
+    Q& operator*() const { return *m_object; }
+    Q* operator->() const { return m_object; }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
@@ -0,0 +1,237 @@
+/**
+ * @file persistent_queue.hpp
+ * @brief **File‑backed MPSC queue** whose ring and cursors live in a shared
+ *        file mapping, so queued messages survive a restart or a crash.
+ *
+ * A `fixed_mpsc_queue` holds no pointers: the ring is inline and the cursors
+ * are plain atomics.  `persistent_mpsc_queue` places one directly in a
+ * `MAP_SHARED` mapping of a file, behind a small header describing its
+ * layout.  Every push and pop therefore writes the page cache, which the
+ * kernel keeps when the process dies; reopening the file maps the same queue
+ * back in – nothing is copied or replayed – and the consumer resumes from its
+ * last stored tail.
+ *
+ * ```cpp
+ * hqlockfree::persistent_mpsc_queue<order, 1 << 20> q("/var/lib/app/orders");
+ * if (q.recovered())
+ *     log("resuming with ", q->size(), " queued orders");
+ * q->push(o);          // any number of producer threads
+ * q->pop(o);           // one consumer
+ * ```
+ *
+ * ## Crash consistency
+ * * A message is recovered iff its `push()` confirmed it (the read head
+ *   passed it).  Slots reserved by producers that died before confirming are
+ *   dropped on reopen (`abandon_reservations()`), together with any later
+ *   slots that were written but queued behind them.
+ * * A message is delivered again iff the consumer died between reading it and
+ *   storing the new tail: delivery is *at least once*.
+ * * The page cache survives a process crash, not a kernel crash or power
+ *   loss; call `sync()` at the points that must reach the disk.
+ *
+ * The file is `flock`ed while open, so a second process opening the same
+ * queue fails rather than corrupting it; the lock goes away with a crashed
+ * owner.
+ */
+
+#pragma once
+
+#include "mpsc_queue.hpp" // fixed_mpsc_queue
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace hqlockfree {
+
+/**
+ * @tparam T            Element type; must be trivially copyable, since its
+ *                      bytes outlive the process that wrote them.
+ * @tparam capacity     Minimum number of elements (rounded up as for
+ *                      @ref fixed_mpsc_queue).
+ * @tparam size_policy  Cache‑line packing policy (default: power‑of‑two).
+ *
+ * @class persistent_mpsc_queue
+ * @brief Owns the file mapping; the queue itself is reached through
+ *        `operator->` / `queue()`.  See the file comment.
+ */
+template <typename T, size_t capacity,
+          cache_size_policy size_policy = cache_size_policy::pow2>
+class persistent_mpsc_queue {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "persistent queues store T as raw bytes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "cursors must be address‑free to be shared via a file");
+
+  public:
+    using buffer_type =
+        fixed_false_sharing_optimized_buffer<T, size_policy, capacity>;
+    /// @brief The same type as `fixed_mpsc_queue<T, capacity, size_policy>`.
+    using queue_type = basic_mpsc_queue<T, buffer_type>;
+
+  private:
+    /// @brief First page of the file; `magic` is stored last on creation.
+    struct file_header {
+        std::atomic<uint64_t> magic;
+        uint64_t version;
+        uint64_t element_size;
+        uint64_t element_alignment;
+        uint64_t slots;
+        uint64_t queue_size;
+        uint64_t interference_size;
+    };
+
+    static constexpr uint64_t file_magic = 0x6871'6c66'7071'7565; ///< hqlfpque
+    static constexpr uint64_t file_version = 1;
+    static constexpr size_t queue_offset = 4096; ///< page after the header
+    static constexpr size_t file_size = queue_offset + sizeof(queue_type);
+
+    static_assert(sizeof(file_header) <= queue_offset &&
+                  alignof(queue_type) <= queue_offset);
+
+    int m_fd = -1;
+    void* m_mapping = nullptr;
+    queue_type* m_queue = nullptr;
+    bool m_recovered = false;
+
+    [[noreturn]] static void fail(const char* what,
+                                  const std::filesystem::path& path) {
+        throw std::system_error(errno, std::generic_category(),
+                                std::string("persistent_mpsc_queue: ") +
+                                    what + " " + path.string());
+    }
+    [[noreturn]] static void foreign(const std::filesystem::path& path) {
+        throw std::runtime_error("persistent_mpsc_queue: " + path.string() +
+                                 " does not hold a queue of this layout");
+    }
+
+    file_header& header() const {
+        return *static_cast<file_header*>(m_mapping);
+    }
+
+    /// @brief Does the header describe exactly this queue type?
+    bool layout_matches() const {
+        const file_header& h = header();
+        return h.version == file_version && h.element_size == sizeof(T) &&
+               h.element_alignment == alignof(T) &&
+               h.slots == buffer_type::static_size &&
+               h.queue_size == sizeof(queue_type) &&
+               h.interference_size == destructive_interference_size;
+    }
+
+    /// @brief Build an empty queue in a zero‑filled file, magic last.
+    void initialise() {
+        m_queue = ::new (static_cast<std::byte*>(m_mapping) + queue_offset)
+            queue_type();
+        file_header& h = header();
+        h.version = file_version;
+        h.element_size = sizeof(T);
+        h.element_alignment = alignof(T);
+        h.slots = buffer_type::static_size;
+        h.queue_size = sizeof(queue_type);
+        h.interference_size = destructive_interference_size;
+        h.magic.store(file_magic, std::memory_order_release);
+    }
+
+    void release() {
+        if (m_mapping != nullptr)
+            munmap(m_mapping, file_size);
+        if (m_fd != -1)
+            close(m_fd);
+        m_mapping = nullptr;
+        m_fd = -1;
+    }
+
+  public:
+    /**
+     * @brief Open the queue stored at @p path, creating it if the file is
+     *        missing, empty or was never fully initialised.
+     * @throws std::system_error if the file cannot be opened, locked, sized
+     *         or mapped; std::runtime_error if it holds anything but a queue
+     *         of this layout (element type, capacity, interference size).
+     */
+    explicit persistent_mpsc_queue(const std::filesystem::path& path) {
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (m_fd == -1)
+            fail("cannot open", path);
+        try {
+            if (flock(m_fd, LOCK_EX | LOCK_NB) != 0)
+                fail("already open elsewhere:", path);
+
+            struct stat st;
+            if (fstat(m_fd, &st) != 0)
+                fail("cannot stat", path);
+            /* sparse: only the pages the queue touches take disk space */
+            if (st.st_size == 0 && ftruncate(m_fd, file_size) != 0)
+                fail("cannot size", path);
+            else if (st.st_size != 0 &&
+                     static_cast<size_t>(st.st_size) != file_size)
+                foreign(path);
+
+            m_mapping = mmap(nullptr, file_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, m_fd, 0);
+            if (m_mapping == MAP_FAILED) {
+                m_mapping = nullptr;
+                fail("cannot map", path);
+            }
+
+            const uint64_t magic =
+                header().magic.load(std::memory_order_acquire);
+            if (magic == file_magic) {
+                if (!layout_matches())
+                    foreign(path);
+                m_queue = std::launder(reinterpret_cast<queue_type*>(
+                    static_cast<std::byte*>(m_mapping) + queue_offset));
+                m_queue->abandon_reservations();
+                m_recovered = true;
+            } else if (magic == 0) {
+                /* new, or creation was cut short before the magic */
+                initialise();
+            } else {
+                foreign(path);
+            }
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    /// @brief Unmap, leaving the queued elements in the file.
+    ~persistent_mpsc_queue() { release(); }
+
+    persistent_mpsc_queue(const persistent_mpsc_queue&) = delete;
+    persistent_mpsc_queue& operator=(const persistent_mpsc_queue&) = delete;
+
+    /// @return `true` if an existing queue was reopened, `false` if created.
+    bool recovered() const { return m_recovered; }
+
+    queue_type& queue() { return *m_queue; }
+    const queue_type& queue() const { return *m_queue; }
+    queue_type* operator->() { return m_queue; }
+    const queue_type* operator->() const { return m_queue; }
+
+    /**
+     * @brief Write the dirty pages back to the file (`msync(MS_SYNC)`), so
+     *        they also survive a kernel crash or power loss.  Blocks.
+     */
+    void sync() {
+        if (msync(m_mapping, file_size, MS_SYNC) != 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "persistent_mpsc_queue: msync");
+    }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
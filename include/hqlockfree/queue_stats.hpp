@@ -0,0 +1,115 @@
+/**
+ * @file queue_stats.hpp
+ * @brief Compile‑time *statistics policies* for the HQ‑LockFree queues.
+ *
+ * Every queue takes a `stats_policy` template parameter and calls a fixed set
+ * of hooks on it from its hot paths:
+ *
+ * | Hook                     | Called when                                   |
+ * |--------------------------|-----------------------------------------------|
+ * | `on_full_wait()`         | once per producer spin while the ring is full |
+ * | `on_empty_pop()`         | a consumer `pop()` finds nothing to read      |
+ * | `on_cas_failure()`       | `write_confirm::confirm_write` retries its CAS|
+ * | `on_reserve(depth)`      | a producer has claimed a slot; @p depth is the|
+ * |                          | ring occupancy including that slot            |
+ * | `on_attach(capacity)`    | once, from the queue constructor              |
+ * | `on_push(index)`         | a producer is about to write slot @p index    |
+ * | `on_pop(index)`          | a consumer has read slot @p index (fan‑out:   |
+ * |                          | once per subscription)                        |
+ * | `on_scan_begin()`        | the fan‑out daemon starts a tail scan         |
+ * | `on_scan_end()`          | ... and has published the new minimum tail    |
+ *
+ * The default, `no_stats`, is an empty type whose hooks are empty inline
+ * functions: it occupies no storage (`[[no_unique_address]]`) and every call
+ * – including computing its arguments – folds away.  `queue_stats` keeps
+ * each counter on its own cache line and can be read from any thread through
+ * `snapshot()`.
+ *
+ * Custom policies derive from `no_stats` and hide only the hooks they need;
+ * see sojourn_sampler.hpp for one that layers on top of another policy.
+ */
+
+#pragma once
+
+#include "cache_utils.hpp" // cache_padded
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hqlockfree {
+
+/// @brief Default policy – all hooks compile to nothing.
+struct no_stats {
+    void on_full_wait() {}
+    void on_empty_pop() {}
+    void on_cas_failure() {}
+    void on_reserve(uint64_t) {}
+    void on_attach(size_t) {}
+    void on_push(uint64_t) {}
+    void on_pop(uint64_t) {}
+    void on_scan_begin() {}
+    void on_scan_end() {}
+};
+
+/// @brief Plain copy of the counters in a @ref queue_stats.
+struct queue_stats_snapshot {
+    uint64_t full_waits = 0;      ///< producer spin iterations on a full ring
+    uint64_t empty_pops = 0;      ///< pops that found no data
+    uint64_t cas_failures = 0;    ///< confirm_write CAS retries
+    uint64_t high_water_mark = 0; ///< deepest occupancy seen by a producer
+};
+
+/**
+ * @class queue_stats
+ * @brief Counting policy; relaxed atomics, one cache line per counter so that
+ *        producers and consumers never contend on the same line.
+ */
+class queue_stats : public no_stats {
+  private:
+    cache_padded<std::atomic<uint64_t>> m_full_waits{0};
+    cache_padded<std::atomic<uint64_t>> m_empty_pops{0};
+    cache_padded<std::atomic<uint64_t>> m_cas_failures{0};
+    cache_padded<std::atomic<uint64_t>> m_high_water_mark{0};
+
+  public:
+    void on_full_wait() {
+        m_full_waits.fetch_add(1, std::memory_order_relaxed);
+    }
+    void on_empty_pop() {
+        m_empty_pops.fetch_add(1, std::memory_order_relaxed);
+    }
+    void on_cas_failure() {
+        m_cas_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    void on_reserve(uint64_t depth) {
+        /* read‑only fast path: the mark only moves when a new maximum is
+         * reached, so the line stays shared in the common case */
+        uint64_t current = m_high_water_mark.load(std::memory_order_relaxed);
+        while (depth > current &&
+               !m_high_water_mark.compare_exchange_weak(
+                   current, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// @brief Copy the counters; safe from any thread, not a consistent cut.
+    queue_stats_snapshot snapshot() const {
+        queue_stats_snapshot out;
+        out.full_waits = m_full_waits.load(std::memory_order_relaxed);
+        out.empty_pops = m_empty_pops.load(std::memory_order_relaxed);
+        out.cas_failures = m_cas_failures.load(std::memory_order_relaxed);
+        out.high_water_mark =
+            m_high_water_mark.load(std::memory_order_relaxed);
+        return out;
+    }
+
+    /// @brief Zero every counter.
+    void reset() {
+        m_full_waits.store(0, std::memory_order_relaxed);
+        m_empty_pops.store(0, std::memory_order_relaxed);
+        m_cas_failures.store(0, std::memory_order_relaxed);
+        m_high_water_mark.store(0, std::memory_order_relaxed);
+    }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
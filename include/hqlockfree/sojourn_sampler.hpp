@@ -0,0 +1,205 @@
+/**
+ * @file sojourn_sampler.hpp
+ * @brief Statistics policy that measures *time in queue* for a sample of
+ *        messages, for use in production rather than benchmarks.
+ *
+ * Every `sample_every`‑th ring index is stamped with `tsc_clock::now()` by the
+ * producer, in a side array that runs parallel to the buffer (one entry per
+ * sampled slot).  The consumer that pops that index records
+ * `now - stamp` into a lock‑free `sojourn_histogram`, which any thread may
+ * query while the queue is live:
+ *
+ * ```cpp
+ * using sampler = hqlockfree::sojourn_sampler<64>;
+ * hqlockfree::mpsc_queue<order, cache_size_policy::pow2, sampler> q(64);
+ * ...
+ * auto p99 = hqlockfree::tsc_clock::to_ns(
+ *     q.stats().sojourn().percentile(0.99));
+ * ```
+ *
+ * The sampling decision is a mask test on the index the queue already has, so
+ * un‑sampled messages pay one predictable branch and no extra memory traffic.
+ * The stamp is written before the slot is published and read before the
+ * consumer releases it, so the queue's own acquire/release pair orders it.
+ *
+ * For `mpmc_fanout` each subscription records its own sojourn of the same
+ * message; the histogram is shared by all subscriptions.
+ *
+ * `base` is another statistics policy whose hooks are forwarded to, so
+ * `sojourn_sampler<64, queue_stats>` keeps the queue_stats counters too.  With
+ * the default `no_stats` queues that do not name a sampler are unaffected.
+ */
+
+#pragma once
+
+#include "cache_utils.hpp" // cache_padded
+#include "queue_stats.hpp" // no_stats
+#include "tsc_clock.hpp"   // tsc_clock
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hqlockfree {
+
+/**
+ * @class sojourn_histogram
+ * @brief Log‑linear (HDR‑style) histogram of tick counts with atomic buckets.
+ *
+ * Values are bucketed by their most significant bit and then linearly by the
+ * next `sub_bucket_bits` bits, bounding relative error by 2^-sub_bucket_bits
+ * (~3% at the default of 5) across the whole 64‑bit range.  `record()` is
+ * safe from any number of threads; readers see a relaxed, not necessarily
+ * consistent, view.
+ */
+template <unsigned sub_bucket_bits = 5> class sojourn_histogram {
+  public:
+    static constexpr size_t sub_buckets = size_t(1) << sub_bucket_bits;
+    static constexpr size_t bucket_count =
+        (64 - sub_bucket_bits + 1) * sub_buckets;
+
+  private:
+    std::array<std::atomic<uint64_t>, bucket_count> m_counts{};
+    cache_padded<std::atomic<uint64_t>> m_max{0};
+
+    static size_t index_of(uint64_t value) {
+        if (value < sub_buckets)
+            return static_cast<size_t>(value);
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) -
+                               sub_bucket_bits - 1;
+        return ((shift + 1) << sub_bucket_bits) +
+               static_cast<size_t>((value >> shift) - sub_buckets);
+    }
+
+    /// @brief Largest value that maps to bucket @p index.
+    static uint64_t value_of(size_t index) {
+        if (index < sub_buckets)
+            return index;
+        const unsigned shift =
+            static_cast<unsigned>(index >> sub_bucket_bits) - 1;
+        const uint64_t sub = (index & (sub_buckets - 1)) + sub_buckets;
+        return ((sub + 1) << shift) - 1;
+    }
+
+  public:
+    void record(uint64_t ticks) {
+        m_counts[index_of(ticks)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t current = m_max.load(std::memory_order_relaxed);
+        while (ticks > current &&
+               !m_max.compare_exchange_weak(current, ticks,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    /// @brief record() without read‑modify‑write instructions, for a
+    /// histogram that only one thread ever records into.
+    void record_single_writer(uint64_t ticks) {
+        auto& count = m_counts[index_of(ticks)];
+        count.store(count.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+        if (ticks > m_max.load(std::memory_order_relaxed))
+            m_max.store(ticks, std::memory_order_relaxed);
+    }
+
+    /// @brief Zero every bucket; racing `record()` calls may survive.
+    void reset() {
+        for (auto& c : m_counts)
+            c.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (const auto& c : m_counts)
+            total += c.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+
+    /// @brief Ticks at quantile @p q in [0, 1] (upper edge of its bucket).
+    uint64_t percentile(double q) const {
+        std::array<uint64_t, bucket_count> counts;
+        uint64_t total = 0;
+        for (size_t i = 0; i < bucket_count; i++)
+            total += (counts[i] = m_counts[i].load(std::memory_order_relaxed));
+        if (total == 0)
+            return 0;
+        const uint64_t max_ticks = max();
+        const auto rank = static_cast<uint64_t>(q * double(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_count; i++) {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(value_of(i), max_ticks);
+        }
+        return max_ticks;
+    }
+};
+
+/**
+ * @tparam sample_every Stamp one index in this many; a power of two.
+ * @tparam base         Statistics policy to forward every hook to.
+ *
+ * @class sojourn_sampler
+ * @brief Statistics policy recording sampled push‑to‑pop latency in ticks.
+ */
+template <size_t sample_every = 64, typename base = no_stats>
+class sojourn_sampler : public base {
+    static_assert(std::has_single_bit(sample_every),
+                  "sample_every must be a power of two");
+
+  private:
+    std::unique_ptr<std::atomic<uint64_t>[]> m_stamps;
+    size_t m_slots = 0;
+    sojourn_histogram<> m_histogram;
+
+    static bool sampled(uint64_t index) {
+        return (index & (sample_every - 1)) == 0;
+    }
+    std::atomic<uint64_t>& stamp_of(uint64_t index) {
+        return m_stamps[(index / sample_every) % m_slots];
+    }
+
+  public:
+    void on_attach(size_t capacity) {
+        /* at most capacity‑1 indices are in flight, so this many sampled
+         * entries can never alias a live one */
+        m_slots = capacity / sample_every + 2;
+        m_stamps = std::make_unique<std::atomic<uint64_t>[]>(m_slots);
+        base::on_attach(capacity);
+    }
+
+    void on_push(uint64_t index) {
+        if (sampled(index))
+            stamp_of(index).store(tsc_clock::now(), std::memory_order_relaxed);
+        base::on_push(index);
+    }
+
+    void on_pop(uint64_t index) {
+        if (sampled(index)) {
+            const uint64_t stamp =
+                stamp_of(index).load(std::memory_order_relaxed);
+            const uint64_t now = tsc_clock::now();
+            m_histogram.record((now > stamp) ? (now - stamp) : 0);
+        }
+        base::on_pop(index);
+    }
+
+    /// @brief Clear the histogram, and the base counters if they reset.
+    void reset() {
+        m_histogram.reset();
+        if constexpr (requires(base& b) { b.reset(); })
+            base::reset();
+    }
+
+    /// @return Sampled sojourn times in ticks (`tsc_clock::to_ns` converts).
+    const sojourn_histogram<>& sojourn() const { return m_histogram; }
+    sojourn_histogram<>& sojourn() { return m_histogram; }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
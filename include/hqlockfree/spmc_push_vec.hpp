@@ -180,6 +180,18 @@ class spmc_push_vec {
         }
     }
 
+    /**
+     * @brief Total element capacity held by the active vector *and* every
+     *        historical one kept alive in m_old_vecs.  Producer thread only.
+     */
+    [[nodiscard]] size_t retained_capacity() const {
+        size_t out = 0;
+        for (const auto& vec : m_old_vecs) {
+            out += vec->capacity();
+        }
+        return out;
+    }
+
     /** @brief Drop all old vectors (dangerous...). */
     void drop_old() {
         auto current = std::move(*m_old_vecs.rbegin());
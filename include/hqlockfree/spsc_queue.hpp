@@ -30,29 +30,43 @@
 #pragma once
 
 #include "cache_utils.hpp" // false_sharing_optimized_buffer & padding helpers
+#include "queue_stats.hpp" // no_stats & queue_stats
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace hqlockfree {
 
 /**
  * @tparam T            Element type.
- * @tparam size_policy  Cache‑line packing policy (default: power‑of‑two).
+ * @tparam ring_buffer  Ring storage: `false_sharing_optimized_buffer` (sized at
+ *                      construction) or `fixed_false_sharing_optimized_buffer`
+ *                      (sized at compile time).
+ * @tparam stats_policy Statistics hooks (default: `no_stats`, zero cost).
+ * @tparam prefetch_policy Prefetching ahead of push and pop (default:
+ *                      `no_prefetch`, zero cost; see `tunable_prefetch`).
  *
- * @class spsc_queue
+ * @class basic_spsc_queue
  * @brief Minimal lock‑free ring buffer for one producer and one consumer.
+ *
+ * Use through the @ref spsc_queue and @ref fixed_spsc_queue aliases.
  */
-template <typename T, cache_size_policy size_policy = cache_size_policy::pow2>
-class spsc_queue {
+template <typename T, typename ring_buffer, typename stats_policy = no_stats,
+          typename prefetch_policy = no_prefetch>
+class basic_spsc_queue {
   private:
     /* ------------------------------------------------------------------
      *  Storage
      * ----------------------------------------------------------------*/
-    false_sharing_optimized_buffer<T, size_policy> m_buffer;
+    ring_buffer m_buffer;
 
-    alignas(cache_line_size) std::uint64_t m_private_head{0}; ///< producer‑only
+    /// @brief producer‑only
+    alignas(destructive_interference_size) std::uint64_t m_private_head{0};
     cache_padded<std::atomic<std::uint64_t>> m_head{
         0}; ///< public head (producer → consumer)
     cache_padded<std::atomic<std::uint64_t>> m_tail{0}; ///< consumer cursor
@@ -60,36 +74,103 @@ class spsc_queue {
     const size_t m_capacity;             ///< total usable slots
     const size_t m_free_capacity_needed; ///< == capacity‑1
 
-    uint64_t get_free_index() {
-        uint64_t index = m_private_head++;
-        while ((index - m_tail.load(std::memory_order_relaxed)) >=
-               m_free_capacity_needed) {
+    [[no_unique_address]] stats_policy m_stats; ///< see queue_stats.hpp
+    [[no_unique_address]] prefetch_policy m_prefetch; ///< see cache_utils.hpp
+
+    /// @brief capacity‑1; a constant when the buffer is sized at compile time.
+    size_t free_capacity_needed() const {
+        if constexpr (ring_buffer::static_size != 0)
+            return ring_buffer::static_size - 1UL;
+        else
+            return m_free_capacity_needed;
+    }
+
+    /// @brief Reserve @p count (< capacity) consecutive slots, returning the
+    /// first – MAY spin until the last of them is free.
+    uint64_t get_free_index(uint64_t count = 1) {
+        uint64_t index = m_private_head;
+        m_private_head += count;
+        uint64_t tail;
+        while ((index + count - 1 -
+                (tail = m_tail.load(std::memory_order_relaxed))) >=
+               free_capacity_needed()) {
             /* busy wait */
+            m_stats.on_full_wait();
         }
+        m_stats.on_reserve(index - tail + count);
         return index;
     }
 
-    /// @brief Mark @p written_index as the newest committed element.
-    void update_read_head(uint64_t written_index) {
-        m_head.store(written_index + 1, std::memory_order_release);
+    /// @brief Publish the @p count elements ending the reservation at
+    /// @p written_index.
+    void update_read_head(uint64_t written_index, uint64_t count = 1) {
+        m_head.store(written_index + count, std::memory_order_release);
     }
 
   public:
     /**
-     * @brief Construct with at least @p min_cache_lines lines or
-     *        @p min_elements elements.
+     * @brief Construct the ring from @p args: for @ref spsc_queue at least
+     *        `min_cache_lines` lines or `min_elements` elements stored
+     *        through `alloc`; for @ref fixed_spsc_queue nothing.
      */
-    explicit spsc_queue(std::size_t min_cache_lines,
-                        std::size_t min_elements = 0)
-        : m_buffer(min_cache_lines, min_elements), m_capacity(m_buffer.size()),
-          m_free_capacity_needed(m_capacity - 1UL) {}
+    template <typename... buffer_args>
+    explicit basic_spsc_queue(buffer_args&&... args)
+        : m_buffer(std::forward<buffer_args>(args)...),
+          m_capacity(m_buffer.size()),
+          m_free_capacity_needed(m_capacity - 1UL) {
+        m_stats.on_attach(m_capacity);
+    }
 
-    spsc_queue(const spsc_queue&) = delete;
-    spsc_queue& operator=(const spsc_queue&) = delete;
-    spsc_queue(spsc_queue&&) = delete;
-    spsc_queue& operator=(spsc_queue&&) = delete;
+    /// @brief Destroy the elements still queued.
+    ~basic_spsc_queue() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            for (uint64_t index = m_tail.load(std::memory_order_relaxed);
+                 index < head; index++)
+                m_buffer.destroy(index);
+        }
+    }
+
+    basic_spsc_queue(const basic_spsc_queue&) = delete;
+    basic_spsc_queue& operator=(const basic_spsc_queue&) = delete;
+    basic_spsc_queue(basic_spsc_queue&&) = delete;
+    basic_spsc_queue& operator=(basic_spsc_queue&&) = delete;
+
+    size_t capacity() const {
+        if constexpr (ring_buffer::static_size != 0)
+            return ring_buffer::static_size;
+        else
+            return m_capacity;
+    }
 
-    size_t capacity() const { return m_capacity; }
+    /// @return The prefetch policy instance (e.g. `prefetch().distance`).
+    const prefetch_policy& prefetch() const { return m_prefetch; }
+    prefetch_policy& prefetch() { return m_prefetch; }
+
+    /**
+     * @brief Warm the queue up before traffic starts: write every line of
+     *        the ring (faulting its pages in), run @p cycles push / pop
+     *        pairs of @p sample through the hot paths, then rewind the
+     *        cursors to 0 and reset the stats if they support it.  Call on
+     *        an empty queue, before the producer and consumer start.
+     */
+    void warm_up(size_t cycles = 1024, const T& sample = T()) {
+        m_buffer.touch();
+        T out = sample;
+        for (size_t i = 0; i < cycles; i++) {
+            push(sample);
+            pop(out);
+        }
+        m_private_head = 0;
+        m_head.store(0, std::memory_order_release);
+        m_tail.store(0, std::memory_order_release);
+        if constexpr (requires { m_stats.reset(); })
+            m_stats.reset();
+    }
+
+    /// @return The statistics policy instance (e.g. `stats().snapshot()`).
+    const stats_policy& stats() const { return m_stats; }
+    stats_policy& stats() { return m_stats; }
 
     size_t size() const {
         auto current_tail = m_tail.load(std::memory_order_acquire);
@@ -99,15 +180,36 @@ class spsc_queue {
     /* ------------------------------------------------------------------
      *  Producer API
      * ----------------------------------------------------------------*/
-    void push(const T& value) {
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(std::move(value)); }
+
+    /// @brief Construct the element in place from @p args.
+    template <typename... Args> void emplace(Args&&... args) {
         uint64_t index = get_free_index();
-        m_buffer[index] = value;
+        m_stats.on_push(index);
+        m_prefetch.template ahead<true>(m_buffer, index);
+        m_buffer.construct(index, std::forward<Args>(args)...);
         update_read_head(index);
     }
-    void push(T&& value) {
-        uint64_t index = get_free_index();
-        m_buffer[index] = std::move(value);
-        update_read_head(index);
+
+    /**
+     * @brief Push the @p count elements at @p values in order, in chunks of
+     *        at most capacity‑1, each reserved and published in one step –
+     *        MAY spin while the ring is full.  Trivially copyable elements
+     *        are copied with `memcpy` kernels rather than one by one.
+     */
+    void push_n(const T* values, size_t count) {
+        while (count != 0) {
+            const uint64_t n =
+                std::min<uint64_t>(count, free_capacity_needed());
+            const uint64_t index = get_free_index(n);
+            for (uint64_t k = 0; k < n; k++)
+                m_stats.on_push(index + k);
+            m_buffer.write_n(index, values, n);
+            update_read_head(index, n);
+            values += n;
+            count -= n;
+        }
     }
 
     /* ------------------------------------------------------------------
@@ -116,12 +218,82 @@ class spsc_queue {
     bool pop(T& value) {
         uint64_t index = m_tail.load(std::memory_order_relaxed);
         uint64_t head = m_head.load(std::memory_order_acquire);
-        if (index >= head)
+        if (index >= head) {
+            m_stats.on_empty_pop();
             return false;
+        }
+        m_prefetch.template ahead<false>(m_buffer, index);
         value = std::move(m_buffer[index]);
+        m_buffer.destroy(index);
+        m_stats.on_pop(index);
         m_tail.store(index + 1, std::memory_order_release);
         return true;
     }
+
+    /**
+     * @brief Pop up to @p max elements into @p values with one cursor update.
+     * @return The number popped, 0 if the ring was empty.
+     */
+    size_t pop_n(T* values, size_t max) {
+        const uint64_t index = m_tail.load(std::memory_order_relaxed);
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        if (index >= head) {
+            m_stats.on_empty_pop();
+            return 0;
+        }
+        const size_t n = std::min<uint64_t>(head - index, max);
+        m_buffer.take_n(index, values, n);
+        for (uint64_t k = 0; k < n; k++)
+            m_stats.on_pop(index + k);
+        m_tail.store(index + n, std::memory_order_release);
+        return n;
+    }
 };
 
+/**
+ * @tparam T            Element type.
+ * @tparam size_policy  Cache‑line packing policy (default: power‑of‑two).
+ * @tparam stats_policy Statistics hooks (default: `no_stats`, zero cost).
+ * @tparam allocator    Ring storage (e.g. `mmap_allocator` for huge pages).
+ * @tparam interference_size Slot granularity for elements larger than a
+ *                      cache line (64, or 128 for adjacent‑line pairs).
+ * @tparam prefetch_policy Prefetching (default: `no_prefetch`, zero cost).
+ *
+ * @brief SPSC queue sized at construction: `spsc_queue<T> q(lines, elems)`.
+ */
+template <typename T, cache_size_policy size_policy = cache_size_policy::pow2,
+          typename stats_policy = no_stats,
+          typename allocator = std::allocator<T>,
+          size_t interference_size = destructive_interference_size,
+          typename prefetch_policy = no_prefetch>
+using spsc_queue = basic_spsc_queue<
+    T,
+    false_sharing_optimized_buffer<T, size_policy, allocator,
+                                   interference_size>,
+    stats_policy, prefetch_policy>;
+
+/**
+ * @tparam T            Element type.
+ * @tparam capacity     Minimum number of elements (rounded up to whole lines,
+ *                      and to a power‑of‑two line count for *pow2*).
+ * @tparam size_policy  Cache‑line packing policy (default: power‑of‑two).
+ * @tparam stats_policy Statistics hooks (default: `no_stats`, zero cost).
+ * @tparam interference_size Slot granularity for elements larger than a
+ *                      cache line (64, or 128 for adjacent‑line pairs).
+ * @tparam prefetch_policy Prefetching (default: `no_prefetch`, zero cost).
+ *
+ * @brief SPSC queue sized at compile time, storage inline in the object:
+ *        `static fixed_spsc_queue<T, 4096> q;`.
+ */
+template <typename T, size_t capacity,
+          cache_size_policy size_policy = cache_size_policy::pow2,
+          typename stats_policy = no_stats,
+          size_t interference_size = destructive_interference_size,
+          typename prefetch_policy = no_prefetch>
+using fixed_spsc_queue = basic_spsc_queue<
+    T,
+    fixed_false_sharing_optimized_buffer<T, size_policy, capacity,
+                                         interference_size>,
+    stats_policy, prefetch_policy>;
+
 } // namespace hqlockfree
\ No newline at end of file
@@ -0,0 +1,184 @@
+/**
+ * @file timer_wheel.hpp
+ * @brief Hierarchical timer wheel: O(1) insertion, expiry in due order to
+ *        within one tick, for the daemon's periodic callbacks.
+ *
+ * Time is an unsigned tick count (the daemon uses microseconds).  Level *l*
+ * has 64 slots of 64^l ticks each, so four levels cover 2^24 ticks (~16 s
+ * at 1 µs) with one slot per tick near the present and coarser slots
+ * further out; entries beyond that wait in an overflow list.  An entry lives
+ * at the lowest level whose slot it shares the higher bits of the current
+ * time with, and moves down (*cascades*) as the time reaches its slot.  A
+ * 64‑bit occupancy mask per level lets `advance()` jump straight to the next
+ * slot that holds anything, so an idle stretch costs one step per level
+ * rather than one per 64 ticks.
+ *
+ * Not thread‑safe: one owner (the daemon worker) schedules and advances.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace hqlockfree {
+
+/**
+ * @tparam value_type What an entry carries back to the expiry callback.
+ *
+ * @class timer_wheel
+ * @brief See the file comment.
+ */
+template <typename value_type> class timer_wheel {
+  public:
+    static constexpr unsigned slot_bits = 6;
+    static constexpr unsigned levels = 4;
+    static constexpr uint64_t slots = uint64_t(1) << slot_bits;
+
+  private:
+    static constexpr uint64_t slot_mask = slots - 1;
+
+    struct entry {
+        uint64_t due;
+        value_type value;
+    };
+    using slot_type = std::vector<entry>;
+
+    uint64_t m_now; ///< first tick not yet expired
+    std::array<std::array<slot_type, slots>, levels> m_slots;
+    std::array<uint64_t, levels> m_occupied{}; ///< bit s = slot s non‑empty
+    slot_type m_overflow;                      ///< beyond the top level
+    size_t m_size = 0;
+
+    static unsigned shift(unsigned level) { return level * slot_bits; }
+
+    /// @brief Place @p e by its due tick, or by now if that has passed.
+    void insert(entry e) {
+        const uint64_t at = std::max(e.due, m_now);
+        for (unsigned level = 0; level < levels; level++) {
+            if ((at >> shift(level + 1)) == (m_now >> shift(level + 1))) {
+                const uint64_t slot = (at >> shift(level)) & slot_mask;
+                m_slots[level][slot].push_back(std::move(e));
+                m_occupied[level] |= uint64_t(1) << slot;
+                return;
+            }
+        }
+        m_overflow.push_back(std::move(e));
+    }
+
+    /// @brief Detach slot @p slot of @p level (callbacks may re‑insert).
+    slot_type take(unsigned level, uint64_t slot) {
+        m_occupied[level] &= ~(uint64_t(1) << slot);
+        return std::exchange(m_slots[level][slot], slot_type{});
+    }
+
+    /// @brief m_now just reached a multiple of 64: move the entries of every
+    /// level that wrapped, top down, to where they now belong.
+    void cascade() {
+        unsigned top = 1;
+        while (top < levels && (m_now >> shift(top) << shift(top)) == m_now)
+            top++;
+        if ((m_now >> shift(levels) << shift(levels)) == m_now) {
+            for (auto& e : std::exchange(m_overflow, slot_type{}))
+                insert(std::move(e));
+        }
+        for (unsigned level = top - 1; level >= 1; level--) {
+            for (auto& e : take(level, (m_now >> shift(level)) & slot_mask))
+                insert(std::move(e));
+        }
+    }
+
+    /// @brief Move the time to @p tick, cascading if it starts a block.
+    void step_to(uint64_t tick) {
+        m_now = tick;
+        if ((m_now & slot_mask) == 0)
+            cascade();
+    }
+
+    /// @brief With nothing left in level 0: the first tick at which a slot of
+    /// a higher level (or the overflow list) cascades, if anything is held.
+    std::optional<uint64_t> next_cascade() const {
+        for (unsigned level = 1; level < levels; level++) {
+            if (m_occupied[level] != 0) {
+                const uint64_t block =
+                    m_now >> shift(level + 1) << shift(level + 1);
+                const auto slot = uint64_t(std::countr_zero(m_occupied[level]));
+                return block | (slot << shift(level));
+            }
+        }
+        if (m_overflow.empty())
+            return std::nullopt;
+        uint64_t earliest = m_overflow.front().due;
+        for (const auto& e : m_overflow)
+            earliest = std::min(earliest, e.due);
+        return earliest >> shift(levels) << shift(levels);
+    }
+
+  public:
+    explicit timer_wheel(uint64_t now = 0) : m_now(now) {}
+
+    /// @brief Add @p value to expire at tick @p due (now, if already past).
+    void schedule(uint64_t due, value_type value) {
+        insert(entry{due, std::move(value)});
+        m_size++;
+    }
+
+    /**
+     * @brief Expire every entry due at or before @p now, calling
+     *        `expire(due, value)` in due order.  @p expire may schedule new
+     *        entries.
+     */
+    template <typename callback>
+    void advance(uint64_t now, callback&& expire) {
+        while (m_now <= now) {
+            const uint64_t pending =
+                m_occupied[0] & (~uint64_t(0) << (m_now & slot_mask));
+            if (pending != 0) {
+                const uint64_t tick =
+                    (m_now & ~slot_mask) | std::countr_zero(pending);
+                if (tick > now) {
+                    m_now = now + 1;
+                    return;
+                }
+                auto expired = take(0, tick & slot_mask);
+                m_size -= expired.size();
+                /* past the tick first: entries @p expire schedules at or
+                 * before it then land in the next tick, not the taken slot */
+                step_to(tick + 1);
+                for (auto& e : expired)
+                    expire(e.due, std::move(e.value));
+            } else if (const auto cascade_at = next_cascade()) {
+                step_to(std::min(*cascade_at, now + 1));
+            } else {
+                m_now = now + 1; // empty: nothing to carry forward
+                return;
+            }
+        }
+    }
+
+    /// @return The earliest due tick, if anything is scheduled.
+    std::optional<uint64_t> next_due() const {
+        std::optional<uint64_t> out;
+        auto consider = [&](const slot_type& slot) {
+            for (const auto& e : slot)
+                out = out ? std::min(*out, e.due) : e.due;
+        };
+        for (unsigned level = 0; level < levels; level++) {
+            if (m_occupied[level] != 0)
+                consider(m_slots[level][std::countr_zero(m_occupied[level])]);
+        }
+        consider(m_overflow);
+        return out;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    uint64_t now() const { return m_now; }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
@@ -0,0 +1,152 @@
+/**
+ * @file trace.hpp
+ * @brief Opt‑in *event tracing* for the HQ‑LockFree queues, exported as a
+ *        Chrome trace (`chrome://tracing`, https://ui.perfetto.dev).
+ *
+ * Tracing has two halves:
+ *
+ * * **Recording** – `queue_tracer` is a statistics policy (see
+ *   queue_stats.hpp) that turns push, pop, full‑ring waits and fan‑out daemon
+ *   scans into fixed‑size `trace_event`s.  Each thread appends to its *own*
+ *   `spsc_queue<trace_event>`, so recording never contends across threads;
+ *   if a thread's buffer is full the event is dropped and counted rather
+ *   than stalling the caller.
+ * * **Export** – while a session is open a `daemon` callback drains every
+ *   thread's buffer each millisecond and streams the events to a JSON file.
+ *   A session still open at exit is stopped by an `atexit` handler.
+ *
+ * ```cpp
+ * using traced = hqlockfree::queue_tracer<>;
+ * hqlockfree::mpsc_queue<int, cache_size_policy::pow2, traced> q(64);
+ *
+ * hqlockfree::start_tracing("pipeline.json");
+ * ...
+ * hqlockfree::stop_tracing();
+ * ```
+ *
+ * Queues that do not name `queue_tracer` have tracing *compiled out*; queues
+ * that do pay a flag check per hook while no session is open.
+ */
+
+#pragma once
+
+#include "daemon.hpp"      // drain thread
+#include "queue_stats.hpp" // no_stats
+#include "tsc_clock.hpp"   // tsc_clock
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace hqlockfree {
+
+enum class trace_kind : uint32_t { push, pop, full_wait, daemon_scan };
+
+/**
+ * @brief One recorded event; instants have `duration == 0`.  32 bytes so two
+ *        share a cache line in the per‑thread buffer.
+ */
+struct trace_event {
+    uint64_t begin;     ///< tsc_clock ticks
+    uint64_t index;     ///< ring index for push / pop, otherwise 0
+    const void* queue;  ///< queue the event belongs to
+    uint32_t duration;  ///< ticks, saturated
+    trace_kind kind;
+};
+
+/// @brief Set while a session is open; checked by `queue_tracer` hooks.
+inline std::atomic<bool> g_tracing{false};
+
+/**
+ * @brief Open a trace session writing to @p path, drained by @p drainer
+ *        (default: the process‑wide daemon; one of your own must outlive
+ *        the session, including a session closed at exit).
+ * @throws std::runtime_error if a session is already open or @p path cannot
+ *         be created.
+ */
+void start_tracing(const std::string& path, daemon* drainer = nullptr);
+
+/// @brief Drain outstanding events, close the file and end the session.
+void stop_tracing();
+
+/// @brief Append @p event to the calling thread's buffer (drops if full).
+void record_trace_event(const trace_event& event);
+
+/// @brief Events dropped because a thread's buffer was full, this session.
+[[nodiscard]] uint64_t dropped_trace_events();
+
+/**
+ * @tparam base Statistics policy to forward every hook to.
+ *
+ * @class queue_tracer
+ * @brief Statistics policy that records queue activity while a trace session
+ *        is open.
+ */
+template <typename base = no_stats> class queue_tracer : public base {
+  private:
+    /// @brief Start of the calling thread's current full‑ring wait, or 0.
+    static uint64_t& wait_begin() {
+        static thread_local uint64_t value = 0;
+        return value;
+    }
+    static uint64_t& scan_begin() {
+        static thread_local uint64_t value = 0;
+        return value;
+    }
+
+    /// @brief Record an event spanning [@p begin, now]; instant if 0.
+    void record(trace_kind kind, uint64_t begin, uint64_t index) {
+        const uint64_t now = tsc_clock::now();
+        const uint64_t elapsed = (begin == 0) ? 0 : now - begin;
+        record_trace_event(trace_event{
+            (begin == 0) ? now : begin, index, this,
+            static_cast<uint32_t>(std::min<uint64_t>(elapsed, UINT32_MAX)),
+            kind});
+    }
+
+  public:
+    void on_full_wait() {
+        if (g_tracing.load(std::memory_order_relaxed) && wait_begin() == 0)
+            wait_begin() = tsc_clock::now();
+        base::on_full_wait();
+    }
+
+    void on_reserve(uint64_t depth) {
+        if (wait_begin() != 0) {
+            if (g_tracing.load(std::memory_order_relaxed))
+                record(trace_kind::full_wait, wait_begin(), 0);
+            wait_begin() = 0;
+        }
+        base::on_reserve(depth);
+    }
+
+    void on_push(uint64_t index) {
+        if (g_tracing.load(std::memory_order_relaxed))
+            record(trace_kind::push, 0, index);
+        base::on_push(index);
+    }
+
+    void on_pop(uint64_t index) {
+        if (g_tracing.load(std::memory_order_relaxed))
+            record(trace_kind::pop, 0, index);
+        base::on_pop(index);
+    }
+
+    void on_scan_begin() {
+        if (g_tracing.load(std::memory_order_relaxed))
+            scan_begin() = tsc_clock::now();
+        base::on_scan_begin();
+    }
+
+    void on_scan_end() {
+        if (scan_begin() != 0) {
+            if (g_tracing.load(std::memory_order_relaxed))
+                record(trace_kind::daemon_scan, scan_begin(), 0);
+            scan_begin() = 0;
+        }
+        base::on_scan_end();
+    }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
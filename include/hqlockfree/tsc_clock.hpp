@@ -0,0 +1,57 @@
+/**
+ * @file tsc_clock.hpp
+ * @brief Raw timestamp counter for cheap in‑process time stamps.
+ *
+ * `now()` is a single `rdtsc` on x86 (steady_clock nanoseconds elsewhere) and
+ * is only meaningful as a *difference* between two reads.  Differences are
+ * converted to nanoseconds through `ns_per_tick()`, calibrated once against
+ * `std::chrono::steady_clock` on first use (~10 ms).  Assumes an invariant
+ * TSC, as on every x86 part of the last decade.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace hqlockfree {
+
+struct tsc_clock {
+    /// @brief Raw tick count.
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /// @brief Nanoseconds per tick, measured over ~10ms on first use.
+    static double ns_per_tick() {
+        static const double value = []() {
+            const auto t0 = std::chrono::steady_clock::now();
+            const uint64_t c0 = now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            const auto t1 = std::chrono::steady_clock::now();
+            const uint64_t c1 = now();
+            return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+                   double(c1 - c0);
+        }();
+        return value;
+    }
+
+    static double to_ns(uint64_t ticks) {
+        return double(ticks) * ns_per_tick();
+    }
+    static uint64_t from_ns(double ns) {
+        return static_cast<uint64_t>(ns / ns_per_tick());
+    }
+};
+
+} // namespace hqlockfree
\ No newline at end of file
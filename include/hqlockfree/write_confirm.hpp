@@ -25,6 +25,7 @@
 #pragma once
 
 #include "cache_utils.hpp" // cache_padded & cache_line_size
+#include "queue_stats.hpp" // no_stats
 
 #include <atomic>
 #include <cstdint>
@@ -53,6 +54,11 @@ class write_confirm {
         return m_write_head.fetch_add(1, std::memory_order_acq_rel);
     }
 
+    /// @brief Reserve @p count consecutive slots; returns the first.
+    uint64_t get_write_index(uint64_t count) {
+        return m_write_head.fetch_add(count, std::memory_order_acq_rel);
+    }
+
     /**
      * @brief Snapshot the consumer‑visible *read head*.
      * @return The read head index
@@ -70,15 +76,55 @@ class write_confirm {
      * point we simply exit early – the work is already done.
      */
     void confirm_write(uint64_t written_index) {
-        uint64_t expected = written_index;
-        const uint64_t desired = written_index + 1;
+        no_stats stats;
+        confirm_write(written_index, stats);
+    }
+
+    /**
+     * @brief As above, reporting every failed CAS to @p stats (see
+     *        queue_stats.hpp).
+     */
+    template <typename stats_policy>
+    void confirm_write(uint64_t written_index, stats_policy& stats) {
+        confirm_write(written_index, 1, stats);
+    }
+
+    /**
+     * @brief Commit the @p count slots starting at @p first_index, reserved
+     *        by one `get_write_index(count)`, in a single step.
+     */
+    template <typename stats_policy>
+    void confirm_write(uint64_t first_index, uint64_t count,
+                       stats_policy& stats) {
+        uint64_t expected = first_index;
+        const uint64_t desired = first_index + count;
         while (!m_read_head.compare_exchange_weak(expected, desired,
                                                   std::memory_order_release)) {
+            stats.on_cas_failure();
             if (expected >= desired)
-                break;                // this shouldn't happen...
-            expected = written_index; // reset expected on failure
+                break;              // this shouldn't happen...
+            expected = first_index; // reset expected on failure
         }
     }
+
+    /**
+     * @brief Rewind both heads to 0.  Only while no producer or consumer is
+     *        using the barrier.
+     */
+    void reset() {
+        m_write_head.store(0, std::memory_order_relaxed);
+        m_read_head.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pull the write head back to the read head, dropping slots that
+     *        were reserved but never confirmed – by producers that died
+     *        mid‑write.  Only while no producer is running.
+     */
+    void abandon_reservations() {
+        m_write_head.store(m_read_head.load(std::memory_order_acquire),
+                           std::memory_order_relaxed);
+    }
 };
 
 } // namespace hqlockfree
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include "perf_counters.hpp"
+
+#include <hqlockfree/mmap_allocator.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+using hqlockfree::cache_size_policy;
+using hqlockfree::mmap_allocator;
+using hqlockfree::mmap_options;
+
+/* -----------------------------------------------------------------------
+ *  Ring storage backends on a large (64 MB) spsc_queue.
+ *
+ *  range(0) selects the backend:
+ *    0 – std::allocator (4 KB pages, faulted on first touch)
+ *    1 – mmap, 4 KB pages, MAP_POPULATE
+ *    2 – mmap, huge pages (hugetlb → THP fallback), prefaulted
+ *    3 – as 2, plus mlock
+ *
+ *  first_pass times construction plus one lap of the ring (where page
+ *  faults land); steady_pass times laps after that.  dtlb_misses from
+ *  perf_counters shows the TLB reach of each backend; the huge_tlb /
+ *  transparent / locked counters record what the host actually granted.
+ * ---------------------------------------------------------------------*/
+
+static constexpr size_t ring_bytes = size_t(64) << 20;
+static constexpr size_t ring_elements = ring_bytes / sizeof(uint64_t);
+
+using mmap_queue = hqlockfree::spsc_queue<uint64_t, cache_size_policy::pow2,
+                                          hqlockfree::no_stats,
+                                          mmap_allocator<uint64_t>>;
+
+/// @brief Type‑erased backend: push/pop one lap through either queue type.
+struct ring {
+    std::unique_ptr<hqlockfree::spsc_queue<uint64_t>> standard;
+    std::unique_ptr<mmap_queue> mapped;
+    hqlockfree::mmap_info info;
+
+    explicit ring(int64_t backend) {
+        if (backend == 0) {
+            standard = std::make_unique<hqlockfree::spsc_queue<uint64_t>>(
+                0, ring_elements);
+            return;
+        }
+        mmap_options options;
+        options.huge_pages = (backend >= 2);
+        options.populate = true;
+        options.lock = (backend == 3);
+        mmap_allocator<uint64_t> alloc(options);
+        mapped = std::make_unique<mmap_queue>(0, ring_elements, alloc);
+        info = alloc.info();
+    }
+
+    /// @brief Push then pop a full ring's worth, touching every line.
+    template <typename queue> static void lap(queue& q) {
+        const size_t n = q.capacity() - 1;
+        for (size_t i = 0; i < n; i++)
+            q.push(i);
+        uint64_t out = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (!q.pop(out) || out != i)
+                throw std::runtime_error("oops");
+        }
+    }
+
+    void lap() {
+        if (standard)
+            lap(*standard);
+        else
+            lap(*mapped);
+    }
+};
+
+static void report_info(benchmark::State& st, const hqlockfree::mmap_info& i) {
+    st.counters["huge_tlb"] = i.huge_tlb;
+    st.counters["transparent"] = i.transparent;
+    st.counters["locked"] = i.locked;
+}
+
+static void first_pass(benchmark::State& st) {
+    perf_counters counters;
+    hqlockfree::mmap_info info;
+    for (auto _ : st) {
+        const auto t0 = std::chrono::steady_clock::now();
+        counters.start();
+        {
+            ring r(st.range(0));
+            r.lap();
+            info = r.info;
+        }
+        counters.stop();
+        st.SetIterationTime(std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - t0)
+                                .count());
+    }
+    counters.report(st, "");
+    report_info(st, info);
+    st.SetBytesProcessed(int64_t(st.iterations()) * int64_t(ring_bytes));
+}
+
+static void steady_pass(benchmark::State& st) {
+    ring r(st.range(0));
+    r.lap();
+
+    perf_counters counters;
+    counters.start();
+    for (auto _ : st) {
+        r.lap();
+    }
+    counters.stop();
+    counters.report(st, "");
+    report_info(st, r.info);
+    st.SetBytesProcessed(int64_t(st.iterations()) * int64_t(ring_bytes));
+}
+
+static void backend_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("backend")->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(first_pass)->Apply(backend_args)->UseManualTime()->Iterations(5);
+BENCHMARK(steady_pass)->Apply(backend_args);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include "queue_wrappers.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+static constexpr size_t queue_size = 1024 << 2;
+static constexpr size_t batch = 32;
+
+/* -----------------------------------------------------------------------
+ *  pod<N> – trivially copyable N‑byte message
+ * ---------------------------------------------------------------------*/
+
+template <size_t bytes> struct pod {
+    uint64_t sequence;
+    std::array<std::byte, bytes - sizeof(uint64_t)> padding;
+};
+
+/* -----------------------------------------------------------------------
+ *  One thread moves `batch` elements in and out per iteration, either one
+ *  push / pop at a time or through push_n / pop_n.  pow2 packing keeps the
+ *  striped layout (strided kernels) below 64 bytes; from 64 bytes up one
+ *  element fills each line and the copies are contiguous memcpys.
+ * ---------------------------------------------------------------------*/
+
+template <queue_type type, size_t bytes, bool bulk>
+static void batch_roundtrip(benchmark::State& st) {
+    using element_type = pod<bytes>;
+    static_assert(sizeof(element_type) == bytes);
+    queue_wrapper<element_type, type> q(queue_size);
+    std::vector<element_type> in(batch), out(batch);
+
+    uint64_t sequence = 0;
+    for (auto _ : st) {
+        for (auto& e : in)
+            e.sequence = sequence++;
+        if constexpr (bulk) {
+            q.push_n(in.data(), batch);
+            if (q.pop_n(out.data(), batch) != batch)
+                throw std::runtime_error("oops");
+        } else {
+            for (const auto& e : in)
+                q.push(e);
+            for (auto& e : out)
+                if (!q.pop(e))
+                    throw std::runtime_error("oops");
+        }
+        if (out.back().sequence != in.back().sequence)
+            throw std::runtime_error("oops");
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    st.SetItemsProcessed(st.iterations() * int64_t(batch));
+    st.SetBytesProcessed(st.iterations() * int64_t(batch * bytes));
+}
+
+#define BULK_PAIR(type, bytes)                                                 \
+    BENCHMARK(batch_roundtrip<type, bytes, false>);                            \
+    BENCHMARK(batch_roundtrip<type, bytes, true>)
+
+#define BULK_SWEEP(type)                                                       \
+    BULK_PAIR(type, 16);                                                       \
+    BULK_PAIR(type, 32);                                                       \
+    BULK_PAIR(type, 64);                                                       \
+    BULK_PAIR(type, 128);                                                      \
+    BULK_PAIR(type, 256)
+
+/* The fan‑out ring only frees slots when the daemon publishes the minimum
+ * tail, so a single thread cycling it measures the daemon period instead; its
+ * push_n / pop_n share these kernels. */
+BULK_SWEEP(queue_type::spsc);
+BULK_SWEEP(queue_type::mpsc);
+
+BENCHMARK_MAIN();
\ No newline at end of file
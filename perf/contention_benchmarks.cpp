@@ -0,0 +1,189 @@
+#include <benchmark/benchmark.h>
+
+#include "queue_wrappers.hpp"
+
+#include <hqlockfree/cache_utils.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static constexpr size_t queue_size = 1024 << 4;
+static constexpr auto window = std::chrono::milliseconds(50);
+
+/* Messages carry the producer id in the top bits and a per-producer sequence
+ * number below it, so every consumer can check per-producer FIFO order. */
+static constexpr unsigned producer_shift = 48;
+static constexpr uint64_t sequence_mask = (uint64_t(1) << producer_shift) - 1;
+
+/* -----------------------------------------------------------------------
+ *  Consumer side: fan-out subscribers each see the whole stream, every
+ *  other container has its consumers compete for elements.
+ * ---------------------------------------------------------------------*/
+
+template <queue_type type> struct contended_queue {
+    queue_wrapper<uint64_t, type> queue;
+    explicit contended_queue(size_t n_elements) : queue(n_elements) {}
+
+    static constexpr bool broadcast = false;
+
+    void push(uint64_t value) { queue.push(value); }
+
+    auto make_consumer() {
+        return [this](uint64_t& value) { return queue.pop(value); };
+    }
+};
+
+template <> struct contended_queue<queue_type::fanout> {
+    hqlockfree::mpmc_fanout<uint64_t> queue;
+    explicit contended_queue(size_t n_elements) : queue(0, n_elements) {}
+
+    static constexpr bool broadcast = true;
+
+    void push(uint64_t value) { queue.push(value); }
+
+    auto make_consumer() {
+        return [sub = queue.subscribe()](uint64_t& value) {
+            return sub->pop(value);
+        };
+    }
+};
+
+/* -----------------------------------------------------------------------
+ *  N producers, M consumers, fixed time window per iteration
+ * ---------------------------------------------------------------------*/
+
+template <queue_type type>
+static void contended_throughput(benchmark::State& st) {
+    const size_t n_producers = static_cast<size_t>(st.range(0));
+    const size_t n_consumers = static_cast<size_t>(st.range(1));
+
+    std::vector<uint64_t> pushed_per_producer(n_producers, 0);
+    uint64_t total_pushed = 0;
+
+    for (auto _ : st) {
+        contended_queue<type> q(queue_size);
+
+        std::atomic<bool> go{false};
+        std::atomic<bool> stop_producers{false};
+        std::atomic<bool> producers_done{false};
+        std::atomic<uint64_t> popped{0};
+        std::vector<hqlockfree::cache_padded<std::atomic<uint64_t>>> counts(
+            n_producers);
+
+        std::vector<std::thread> consumers;
+        for (size_t c = 0; c < n_consumers; c++) {
+            consumers.emplace_back([&, pop = q.make_consumer()]() mutable {
+                std::vector<uint64_t> next(n_producers, 0);
+                uint64_t local = 0;
+                uint64_t value = 0;
+                while (true) {
+                    /* producers are joined once this is set, so an empty
+                     * pop observed afterwards is final */
+                    const bool done =
+                        producers_done.load(std::memory_order_acquire);
+                    if (pop(value)) {
+                        const uint64_t producer = value >> producer_shift;
+                        const uint64_t sequence = value & sequence_mask;
+                        if (sequence < next[producer]) {
+                            throw std::runtime_error("oops");
+                        }
+                        next[producer] = sequence + 1;
+                        local++;
+                    } else if (done) {
+                        break;
+                    }
+                }
+                popped.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < n_producers; p++) {
+            producers.emplace_back([&, p]() {
+                const uint64_t tag = uint64_t(p) << producer_shift;
+                uint64_t sequence = 0;
+                while (!go.load(std::memory_order_acquire)) {
+                }
+                while (!stop_producers.load(std::memory_order_relaxed)) {
+                    q.push(tag | sequence++);
+                }
+                counts[p].store(sequence, std::memory_order_relaxed);
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(window);
+        stop_producers.store(true, std::memory_order_relaxed);
+        for (auto& t : producers)
+            t.join();
+        const auto end = std::chrono::steady_clock::now();
+        producers_done.store(true, std::memory_order_release);
+        for (auto& t : consumers)
+            t.join();
+
+        uint64_t iteration_pushed = 0;
+        for (size_t p = 0; p < n_producers; p++) {
+            const uint64_t n = counts[p].load(std::memory_order_relaxed);
+            pushed_per_producer[p] += n;
+            iteration_pushed += n;
+        }
+        const uint64_t expected =
+            iteration_pushed *
+            (contended_queue<type>::broadcast ? n_consumers : 1);
+        if (popped.load(std::memory_order_relaxed) != expected) {
+            throw std::runtime_error("oops");
+        }
+        total_pushed += iteration_pushed;
+
+        const double seconds =
+            std::chrono::duration<double>(end - start).count();
+        st.SetIterationTime(seconds);
+    }
+
+    /* Jain's index: 1.0 when every producer got the same share, 1/N when a
+     * single producer monopolised the queue. */
+    double sum = 0, sum_sq = 0;
+    for (auto n : pushed_per_producer) {
+        sum += double(n);
+        sum_sq += double(n) * double(n);
+    }
+    const auto [min_it, max_it] = std::minmax_element(
+        pushed_per_producer.begin(), pushed_per_producer.end());
+    const double mean = sum / double(n_producers);
+
+    st.counters["fairness"] =
+        (sum_sq > 0) ? (sum * sum) / (double(n_producers) * sum_sq) : 0;
+    st.counters["min_share"] = (mean > 0) ? double(*min_it) / mean : 0;
+    st.counters["max_share"] = (mean > 0) ? double(*max_it) / mean : 0;
+    st.SetItemsProcessed(static_cast<int64_t>(total_pushed));
+}
+
+static void single_consumer_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"producers", "consumers"})
+        ->ArgsProduct({{1, 2, 4, 8}, {1}})
+        ->UseManualTime()
+        ->Iterations(10);
+}
+
+static void multi_consumer_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"producers", "consumers"})
+        ->ArgsProduct({{1, 2, 4, 8}, {1, 2, 4}})
+        ->UseManualTime()
+        ->Iterations(10);
+}
+
+BENCHMARK(contended_throughput<queue_type::mpsc>)->Apply(single_consumer_args);
+BENCHMARK(contended_throughput<queue_type::fanout>)
+    ->Apply(multi_consumer_args);
+BENCHMARK(contended_throughput<queue_type::boost_mpsc>)
+    ->Apply(multi_consumer_args);
+BENCHMARK(contended_throughput<queue_type::mutex>)->Apply(multi_consumer_args);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/daemon.hpp>
+#include <hqlockfree/mpmc_fanout.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/* -----------------------------------------------------------------------
+ *  Construct + destroy one fan‑out while range(0) others, each with one
+ *  subscriber, keep the shared daemon busy scanning
+ * ---------------------------------------------------------------------*/
+
+using fanout = hqlockfree::mpmc_fanout<uint64_t>;
+
+static void fanout_lifecycle(benchmark::State& st) {
+    const auto live = static_cast<size_t>(st.range(0));
+    std::vector<std::unique_ptr<fanout>> others;
+    std::vector<std::shared_ptr<fanout::subscription_handle>> handles;
+    for (size_t i = 0; i < live; i++) {
+        others.push_back(std::make_unique<fanout>(0, 1024));
+        handles.push_back(others.back()->subscribe());
+    }
+
+    for (auto _ : st) {
+        auto q = std::make_unique<fanout>(0, 1024);
+        benchmark::DoNotOptimize(q.get());
+    }
+    st.counters["live_fanouts"] = double(live);
+}
+
+BENCHMARK(fanout_lifecycle)
+    ->ArgName("live")
+    ->Arg(0)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::kMicrosecond);
+
+/* -----------------------------------------------------------------------
+ *  Bare add / remove on a private daemon with range(0) callbacks
+ * ---------------------------------------------------------------------*/
+
+static void callback_add_remove(benchmark::State& st) {
+    const auto live = static_cast<size_t>(st.range(0));
+    hqlockfree::daemon d;
+    std::vector<hqlockfree::callback_key_t> keys;
+    uint64_t sink = 0;
+    for (size_t i = 0; i < live; i++)
+        keys.push_back(d.add_callback([&sink]() {
+            benchmark::DoNotOptimize(sink++);
+        }));
+
+    for (auto _ : st) {
+        const auto key = d.add_callback([]() {});
+        d.remove_callback(key);
+    }
+    for (auto key : keys)
+        d.remove_callback(key);
+}
+
+BENCHMARK(callback_add_remove)
+    ->ArgName("live")
+    ->Arg(0)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::kMicrosecond);
+
+/* -----------------------------------------------------------------------
+ *  Min‑tail refresh staleness: range(0) fan‑out scans spread by owner hash
+ *  over range(1) workers.  A probe's consumer advances and then waits until
+ *  its scan has published the new tail – how long a producer would see
+ *  stale free space.  The scans reproduce update_min_tail() (lock, read
+ *  each subscriber's tail, publish the minimum), since fan‑outs register
+ *  on the shared single‑worker daemon.  Spinning workers need a CPU each
+ *  (plus one for the probe); with fewer, this times the scheduler instead
+ * ---------------------------------------------------------------------*/
+
+struct fanout_scan {
+    std::mutex subscriptions;
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> min_tail{0};
+
+    void update_min_tail() {
+        std::lock_guard<std::mutex> lock(subscriptions);
+        min_tail.store(tail.load(std::memory_order_relaxed),
+                       std::memory_order_release);
+    }
+};
+
+static void min_tail_staleness(benchmark::State& st) {
+    const auto fanouts = static_cast<size_t>(st.range(0));
+    const auto workers = static_cast<size_t>(st.range(1));
+    hqlockfree::daemon d(workers);
+    std::vector<std::unique_ptr<fanout_scan>> scans;
+    std::vector<hqlockfree::callback_key_t> keys;
+    for (size_t i = 0; i < fanouts; i++) {
+        auto& scan = *scans.emplace_back(std::make_unique<fanout_scan>());
+        keys.push_back(d.add_callback_to(d.shard_of(&scan), [&scan]() {
+            scan.update_min_tail();
+        }));
+    }
+
+    fanout_scan& probe = *scans[fanouts / 2];
+    uint64_t tail = 0;
+    for (auto _ : st) {
+        const auto start = std::chrono::steady_clock::now();
+        probe.tail.store(++tail, std::memory_order_relaxed);
+        while (probe.min_tail.load(std::memory_order_acquire) != tail)
+            std::this_thread::yield();
+        st.SetIterationTime(std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - start)
+                                .count());
+    }
+    for (auto key : keys)
+        d.remove_callback(key);
+    st.counters["fanouts"] = double(fanouts);
+    st.counters["workers"] = double(workers);
+    st.counters["cpus"] = double(std::thread::hardware_concurrency());
+}
+
+BENCHMARK(min_tail_staleness)
+    ->ArgNames({"fanouts", "workers"})
+    ->ArgsProduct({{1, 10, 100, 1000}, {1, 2, 4}})
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+
+/* -----------------------------------------------------------------------
+ *  Producer stall on a critical fan‑out (64 slots, one consumer) while 50
+ *  bulk fan‑outs with 8 subscribers each share the default daemon: the
+ *  critical bus scanned there too, or on a dedicated daemon.  Each
+ *  iteration pushes 4096 messages; the push that waits longest for the
+ *  min tail is reported as max_stall_us
+ * ---------------------------------------------------------------------*/
+
+template <bool dedicated>
+static void critical_producer_stall(benchmark::State& st) {
+    using clock = std::chrono::steady_clock;
+    std::vector<std::unique_ptr<fanout>> bulk;
+    std::vector<std::shared_ptr<fanout::subscription_handle>> bulk_readers;
+    for (int i = 0; i < 50; i++) {
+        bulk.push_back(std::make_unique<fanout>(0, 1024));
+        for (int r = 0; r < 8; r++)
+            bulk_readers.push_back(bulk.back()->subscribe());
+    }
+
+    std::optional<hqlockfree::daemon> own; // only when used: it spins
+    std::unique_ptr<fanout> critical;
+    if constexpr (dedicated)
+        critical = std::make_unique<fanout>(own.emplace(1), 0, 64);
+    else
+        critical = std::make_unique<fanout>(0, 64);
+    auto reader = critical->subscribe();
+    std::atomic<bool> stop{false};
+    std::thread consumer([&]() {
+        uint64_t value;
+        while (!stop.load(std::memory_order_relaxed))
+            reader->pop(value);
+    });
+
+    double max_stall_us = 0;
+    for (auto _ : st) {
+        for (uint64_t i = 0; i < 4096; i++) {
+            const auto start = clock::now();
+            critical->push(i);
+            max_stall_us = std::max(
+                max_stall_us,
+                std::chrono::duration<double, std::micro>(clock::now() - start)
+                    .count());
+        }
+    }
+    stop = true;
+    consumer.join();
+    st.counters["max_stall_us"] = max_stall_us;
+    st.counters["cpus"] = double(std::thread::hardware_concurrency());
+    st.SetItemsProcessed(int64_t(st.iterations()) * 4096);
+}
+
+BENCHMARK(critical_producer_stall<false>)->Unit(benchmark::kMicrosecond);
+BENCHMARK(critical_producer_stall<true>)->Unit(benchmark::kMicrosecond);
+
+/* -----------------------------------------------------------------------
+ *  Callback runs per second with range(0) trivial every‑pass callbacks on a
+ *  private daemon; build with and without HQLOCKFREE_DAEMON_PROFILING to
+ *  see what timing each run costs.  The benchmark thread only sleeps
+ * ---------------------------------------------------------------------*/
+
+static void callback_run_rate(benchmark::State& st) {
+    const auto callbacks = static_cast<size_t>(st.range(0));
+    hqlockfree::daemon d;
+    std::atomic<uint64_t> runs{0};
+    std::vector<hqlockfree::callback_key_t> keys;
+    for (size_t i = 0; i < callbacks; i++)
+        keys.push_back(d.add_callback([&runs]() {
+            runs.fetch_add(1, std::memory_order_relaxed);
+        }));
+
+    const uint64_t before = runs.load();
+    for (auto _ : st)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    st.counters["runs"] = benchmark::Counter(double(runs.load() - before),
+                                             benchmark::Counter::kIsRate);
+    for (auto key : keys)
+        d.remove_callback(key);
+}
+
+BENCHMARK(callback_run_rate)
+    ->ArgName("callbacks")
+    ->Arg(1)
+    ->Arg(100)
+    ->Iterations(10)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/* -----------------------------------------------------------------------
+ *  One 1 ms periodic callback, 200 runs, under each wait policy: how far
+ *  the gaps between runs stray from the period, and how much CPU the
+ *  daemon burns meanwhile (the benchmark thread only sleeps).  Run alone
+ *  (--benchmark_filter=jitter): the shared daemon the fan‑outs above start
+ *  keeps spinning and would be counted too
+ * ---------------------------------------------------------------------*/
+
+template <hqlockfree::wait_policy policy>
+static void periodic_jitter(benchmark::State& st) {
+    using clock = std::chrono::steady_clock;
+    constexpr auto period = std::chrono::milliseconds(1);
+    constexpr size_t runs = 200;
+    double total_jitter_us = 0, max_jitter_us = 0, cpu_share = 0;
+
+    for (auto _ : st) {
+        std::vector<clock::time_point> times;
+        times.reserve(runs + 64);
+        hqlockfree::daemon d(policy);
+        const std::clock_t cpu_start = std::clock();
+        const auto wall_start = clock::now();
+        const auto key = d.schedule_every(period, [&times]() {
+            if (times.size() < times.capacity())
+                times.push_back(clock::now());
+        });
+        std::this_thread::sleep_for(period * runs);
+        d.remove_callback(key);
+        const double wall =
+            std::chrono::duration<double>(clock::now() - wall_start).count();
+        cpu_share += double(std::clock() - cpu_start) / CLOCKS_PER_SEC / wall;
+
+        for (size_t i = 1; i < times.size(); i++) {
+            const double jitter_us = std::abs(
+                std::chrono::duration<double, std::micro>(
+                    times[i] - times[i - 1] - period)
+                    .count());
+            total_jitter_us += jitter_us / double(times.size() - 1);
+            max_jitter_us = std::max(max_jitter_us, jitter_us);
+        }
+    }
+    const auto n = double(st.iterations());
+    st.counters["mean_jitter_us"] = total_jitter_us / n;
+    st.counters["max_jitter_us"] = max_jitter_us;
+    st.counters["cpu_share"] = cpu_share / n;
+}
+
+BENCHMARK(periodic_jitter<hqlockfree::wait_policy::spin>)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(periodic_jitter<hqlockfree::wait_policy::sleep>)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(periodic_jitter<hqlockfree::wait_policy::hybrid>)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/mpmc_fanout.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+static constexpr size_t queue_size = 1024 << 4;
+
+using hqlockfree::cache_size_policy;
+
+/* -----------------------------------------------------------------------
+ *  Runtime‑sized queues (capacity loaded from the object, indexers held as
+ *  members) against fixed_* variants whose index math folds to constants.
+ *  Both *pow2* and *exact* policies are run: *exact* is where the runtime
+ *  version pays a real division per access.
+ * ---------------------------------------------------------------------*/
+
+enum class queue_type { spsc, mpsc, fanout };
+
+template <queue_type type, bool fixed, cache_size_policy policy>
+struct queue_of {};
+
+template <cache_size_policy policy>
+struct queue_of<queue_type::spsc, false, policy>
+    : hqlockfree::spsc_queue<uint64_t, policy> {
+    queue_of() : hqlockfree::spsc_queue<uint64_t, policy>(0, queue_size) {}
+};
+template <cache_size_policy policy>
+struct queue_of<queue_type::spsc, true, policy>
+    : hqlockfree::fixed_spsc_queue<uint64_t, queue_size, policy> {};
+
+template <cache_size_policy policy>
+struct queue_of<queue_type::mpsc, false, policy>
+    : hqlockfree::mpsc_queue<uint64_t, policy> {
+    queue_of() : hqlockfree::mpsc_queue<uint64_t, policy>(0, queue_size) {}
+};
+template <cache_size_policy policy>
+struct queue_of<queue_type::mpsc, true, policy>
+    : hqlockfree::fixed_mpsc_queue<uint64_t, queue_size, policy> {};
+
+template <typename base> struct fanout_of : base {
+    std::shared_ptr<typename base::subscription_handle> sub;
+    template <typename... Args>
+    explicit fanout_of(Args&&... args)
+        : base(std::forward<Args>(args)...), sub(this->subscribe()) {}
+    bool pop(uint64_t& value) { return sub->pop(value); }
+};
+template <cache_size_policy policy>
+struct queue_of<queue_type::fanout, false, policy>
+    : fanout_of<hqlockfree::mpmc_fanout<uint64_t, policy>> {
+    queue_of()
+        : fanout_of<hqlockfree::mpmc_fanout<uint64_t, policy>>(0, queue_size) {
+    }
+};
+template <cache_size_policy policy>
+struct queue_of<queue_type::fanout, true, policy>
+    : fanout_of<hqlockfree::fixed_mpmc_fanout<uint64_t, queue_size, policy>> {
+};
+
+template <queue_type type, bool fixed, cache_size_policy policy>
+static void fixed_roundtrip_single_thread(benchmark::State& st) {
+    auto q = std::make_unique<queue_of<type, fixed, policy>>();
+
+    uint64_t iteration = 0;
+    for (auto _ : st) {
+        const uint64_t to_send = iteration++;
+        q->push(to_send);
+        uint64_t to_recv = 0;
+        q->pop(to_recv);
+        if (to_recv != to_send) {
+            throw std::runtime_error("oops");
+        }
+    }
+    st.counters["capacity"] = double(q->capacity());
+    st.SetItemsProcessed(st.iterations());
+}
+
+template <queue_type type, bool fixed, cache_size_policy policy>
+static void fixed_push_single_producer(benchmark::State& st) {
+    auto q = std::make_unique<queue_of<type, fixed, policy>>();
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+
+    std::thread thread([&]() {
+        started.test_and_set();
+        started.notify_all();
+        uint64_t out = 0;
+        while (should_run.load(std::memory_order_relaxed)) {
+            benchmark::DoNotOptimize(q->pop(out));
+        }
+    });
+    started.wait(false);
+
+    uint64_t iteration = 0;
+    for (auto _ : st) {
+        q->push(iteration++);
+    }
+
+    should_run = false;
+    if (thread.joinable())
+        thread.join();
+    st.SetItemsProcessed(st.iterations());
+}
+
+#define FIXED_PAIR(bench, type, policy)                                        \
+    BENCHMARK(bench<queue_type::type, false, cache_size_policy::policy>);      \
+    BENCHMARK(bench<queue_type::type, true, cache_size_policy::policy>);
+
+#define FIXED_SWEEP(bench)                                                     \
+    FIXED_PAIR(bench, spsc, pow2)                                              \
+    FIXED_PAIR(bench, spsc, exact)                                             \
+    FIXED_PAIR(bench, mpsc, pow2)                                              \
+    FIXED_PAIR(bench, mpsc, exact)                                             \
+    FIXED_PAIR(bench, fanout, pow2)                                            \
+    FIXED_PAIR(bench, fanout, exact)
+
+FIXED_SWEEP(fixed_roundtrip_single_thread)
+FIXED_SWEEP(fixed_push_single_producer)
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include "topology.hpp"
+
+#include <hqlockfree/cache_utils.hpp>
+#include <hqlockfree/interference.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+/* -----------------------------------------------------------------------
+ *  cursor_pair<N> – a head and a tail cursor N bytes apart
+ *
+ *  Both live in one 256‑byte block, so at N = 64 they sit on the two halves
+ *  of a 128‑byte adjacent‑line pair: separate lines, but prefetched together.
+ *  That is the layout a 64‑byte `cache_padded` produces on CPUs whose
+ *  destructive interference size is really 128.
+ * ---------------------------------------------------------------------*/
+
+template <size_t separation> struct alignas(256) cursor_pair {
+    std::atomic<uint64_t> head{0};
+    std::byte gap[separation - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> tail{0};
+};
+
+/* The producer advances head at most `window` ahead of tail, the consumer
+ * chases it: the same traffic an spsc_queue's cursors see, minus the ring. */
+static constexpr uint64_t window = 64;
+
+static void placement_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("placement");
+    for (auto p : all_placements) {
+        if (find_cpu_pair(p))
+            b->Arg(static_cast<int64_t>(p));
+    }
+}
+
+template <size_t separation>
+static void cursor_ping_pong(benchmark::State& st) {
+    const auto where = static_cast<placement>(st.range(0));
+    const auto cpus = *find_cpu_pair(where);
+    st.SetLabel(describe(where, cpus));
+    scoped_pin pin(cpus.first);
+
+    cursor_pair<separation> cursors;
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+
+    std::thread consumer([&]() {
+        pin_current_thread(cpus.second);
+        started.test_and_set();
+        started.notify_all();
+        uint64_t tail = 0;
+        while (should_run.load(std::memory_order_relaxed)) {
+            if (tail < cursors.head.load(std::memory_order_acquire))
+                cursors.tail.store(++tail, std::memory_order_release);
+        }
+    });
+    started.wait(false);
+
+    uint64_t head = 0;
+    for (auto _ : st) {
+        while (head - cursors.tail.load(std::memory_order_acquire) >=
+               window) {
+        }
+        cursors.head.store(++head, std::memory_order_release);
+    }
+
+    should_run = false;
+    if (consumer.joinable())
+        consumer.join();
+
+    st.counters["separation"] = double(separation);
+    st.SetItemsProcessed(st.iterations());
+}
+
+BENCHMARK(cursor_ping_pong<64>)->Apply(placement_args);
+BENCHMARK(cursor_ping_pong<128>)->Apply(placement_args);
+BENCHMARK(cursor_ping_pong<256>)->Apply(placement_args);
+
+/* -----------------------------------------------------------------------
+ *  What the run‑time probe recommends for this machine
+ * ---------------------------------------------------------------------*/
+
+static void interference_probe(benchmark::State& st) {
+    hqlockfree::interference_report report;
+    for (auto _ : st) {
+        report = hqlockfree::probe_interference();
+    }
+    st.counters["compiled"] = double(hqlockfree::destructive_interference_size);
+    st.counters["coherency_line"] = double(report.coherency_line_size);
+    st.counters["measured"] = double(report.measured);
+    st.counters["recommended"] = double(report.recommended);
+    st.counters["ns_64"] = report.ns_per_op[0];
+    st.counters["ns_128"] = report.ns_per_op[1];
+    st.counters["ns_256"] = report.ns_per_op[2];
+    st.counters["ns_page"] = report.ns_per_op[3];
+}
+
+BENCHMARK(interference_probe)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/cache_utils.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+static constexpr size_t queue_size = 1024 << 2;
+static constexpr auto window = std::chrono::milliseconds(50);
+
+using hqlockfree::cache_size_policy;
+
+/* -----------------------------------------------------------------------
+ *  payload<N> – N‑byte message, larger than a cache line
+ * ---------------------------------------------------------------------*/
+
+template <size_t bytes> struct payload {
+    uint64_t sequence;
+    std::array<std::byte, bytes - sizeof(uint64_t)> padding;
+};
+
+/* Producers claim consecutive indices, so with one element per line the
+ * neighbouring slots they write at the same moment are the ones that must not
+ * share a line – or, with 128, an adjacent‑line prefetch pair. */
+template <size_t bytes, size_t interference_size>
+using large_queue =
+    hqlockfree::mpsc_queue<payload<bytes>, cache_size_policy::pow2,
+                           hqlockfree::no_stats, std::allocator<payload<bytes>>,
+                           interference_size>;
+
+/* -----------------------------------------------------------------------
+ *  N producers, one consumer, fixed time window per iteration
+ * ---------------------------------------------------------------------*/
+
+template <size_t bytes, size_t interference_size>
+static void large_element_throughput(benchmark::State& st) {
+    using queue_type = large_queue<bytes, interference_size>;
+    using line_type = hqlockfree::cache_line<payload<bytes>,
+                                             cache_size_policy::pow2,
+                                             interference_size>;
+    const size_t n_producers = static_cast<size_t>(st.range(0));
+    uint64_t total = 0;
+
+    for (auto _ : st) {
+        queue_type q(0, queue_size);
+        std::atomic<bool> go{false};
+        std::atomic<bool> stop{false};
+        std::atomic<bool> producers_done{false};
+        std::atomic<uint64_t> pushed{0};
+
+        std::thread consumer([&]() {
+            payload<bytes> out{};
+            while (true) {
+                const bool done =
+                    producers_done.load(std::memory_order_acquire);
+                if (q.pop(out)) {
+                    benchmark::DoNotOptimize(out);
+                } else if (done) {
+                    break;
+                }
+            }
+        });
+
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < n_producers; p++) {
+            producers.emplace_back([&]() {
+                payload<bytes> in{};
+                while (!go.load(std::memory_order_acquire)) {
+                }
+                while (!stop.load(std::memory_order_relaxed)) {
+                    q.push(in);
+                    in.sequence++;
+                }
+                pushed.fetch_add(in.sequence, std::memory_order_relaxed);
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(window);
+        stop.store(true, std::memory_order_relaxed);
+        for (auto& t : producers)
+            t.join();
+        const auto end = std::chrono::steady_clock::now();
+        producers_done.store(true, std::memory_order_release);
+        consumer.join();
+
+        total += pushed.load(std::memory_order_relaxed);
+        st.SetIterationTime(
+            std::chrono::duration<double>(end - start).count());
+    }
+
+    st.counters["slot_bytes"] = double(sizeof(line_type));
+    st.counters["slot_align"] = double(alignof(line_type));
+    st.SetItemsProcessed(static_cast<int64_t>(total));
+    st.SetBytesProcessed(static_cast<int64_t>(total * bytes));
+}
+
+static void producer_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("producers")
+        ->Arg(1)
+        ->Arg(2)
+        ->Arg(4)
+        ->UseManualTime()
+        ->Iterations(10);
+}
+
+#define LARGE_PAIR(bytes)                                                      \
+    BENCHMARK(large_element_throughput<bytes, 64>)->Apply(producer_args);      \
+    BENCHMARK(large_element_throughput<bytes, 128>)->Apply(producer_args)
+
+LARGE_PAIR(96);
+LARGE_PAIR(200);
+LARGE_PAIR(1000);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "latency_utils.hpp"
+#include "queue_wrappers.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+static constexpr size_t queue_size = 1024 << 4;
+static constexpr size_t messages_per_iteration = 1000;
+
+/* -----------------------------------------------------------------------
+ *  Sojourn time: push‑side stamp to pop, recorded by the consumer.
+ *
+ *  range(0) is the offered rate in messages/second, 0 meaning flat out.
+ *  When paced, each message is stamped with its *scheduled* send time
+ *  rather than the time push() was actually called, so a producer that
+ *  falls behind (queue full, preempted) is charged for the delay it
+ *  inflicts on every message queued up behind it – i.e. the measurement
+ *  is corrected for coordinated omission.
+ * ---------------------------------------------------------------------*/
+
+template <queue_type type> static void sojourn_latency(benchmark::State& st) {
+    const auto rate = static_cast<double>(st.range(0));
+    const uint64_t interval =
+        (rate > 0) ? tsc_clock::from_ns(1e9 / rate) : uint64_t(0);
+
+    queue_wrapper<stamped_message, type> q(queue_size);
+    latency_histogram<> histogram;
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+
+    std::thread consumer([&]() {
+        started.test_and_set();
+        started.notify_all();
+        uint64_t next = 0;
+
+        while (true) {
+            const bool done = !should_run.load(std::memory_order_acquire);
+            stamped_message msg;
+            if (q.pop(msg)) {
+                histogram.record_single_writer(tsc_clock::now() - msg.stamp);
+                if (msg.sequence != (next++)) {
+                    throw std::runtime_error("oops");
+                }
+            } else if (done) {
+                break;
+            }
+        }
+    });
+
+    started.wait(false);
+
+    uint64_t sequence = 0;
+    for (auto _ : st) {
+        uint64_t scheduled = tsc_clock::now();
+        for (size_t i = 0; i < messages_per_iteration; i++) {
+            uint64_t stamp = tsc_clock::now();
+            if (interval != 0) {
+                while (stamp < scheduled) {
+                    stamp = tsc_clock::now();
+                }
+                stamp = scheduled;
+                scheduled += interval;
+            }
+            q.push(stamped_message{stamp, sequence++});
+        }
+    }
+
+    should_run.store(false, std::memory_order_release);
+    if (consumer.joinable())
+        consumer.join();
+
+    st.SetItemsProcessed(static_cast<int64_t>(sequence));
+    report_latency(st, histogram);
+}
+
+static void rate_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("rate")->Arg(0)->Arg(100'000)->Arg(1'000'000);
+}
+
+BENCHMARK(sojourn_latency<queue_type::spsc>)->Apply(rate_args);
+BENCHMARK(sojourn_latency<queue_type::mpsc>)->Apply(rate_args);
+BENCHMARK(sojourn_latency<queue_type::fanout>)->Apply(rate_args);
+
+BENCHMARK_MAIN();
\ No newline at end of file
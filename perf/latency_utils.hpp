@@ -0,0 +1,39 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/sojourn_sampler.hpp>
+#include <hqlockfree/tsc_clock.hpp>
+
+#include <cstdint>
+
+/// @brief Calibrated rdtsc clock, shared with the library's sojourn sampler.
+using hqlockfree::tsc_clock;
+
+/* -----------------------------------------------------------------------
+ *  latency_histogram – the library's HDR‑style log‑linear histogram, at a
+ *  finer resolution: < 1% relative error at 7 sub‑bucket bits.  The
+ *  benchmarks record from one thread with record_single_writer() and read
+ *  after the writer is joined
+ * ---------------------------------------------------------------------*/
+
+template <unsigned sub_bucket_bits = 7>
+using latency_histogram = hqlockfree::sojourn_histogram<sub_bucket_bits>;
+
+/// @brief Message type for sojourn‑time benchmarks.
+struct stamped_message {
+    uint64_t stamp;
+    uint64_t sequence;
+};
+
+/// @brief Publish p50/p99/p99.9/p99.99/max of a tick histogram as
+/// nanosecond user counters.
+template <unsigned sub_bucket_bits>
+void report_latency(benchmark::State& st,
+                    const latency_histogram<sub_bucket_bits>& histogram) {
+    st.counters["p50_ns"] = tsc_clock::to_ns(histogram.percentile(0.50));
+    st.counters["p99_ns"] = tsc_clock::to_ns(histogram.percentile(0.99));
+    st.counters["p99.9_ns"] = tsc_clock::to_ns(histogram.percentile(0.999));
+    st.counters["p99.99_ns"] = tsc_clock::to_ns(histogram.percentile(0.9999));
+    st.counters["max_ns"] = tsc_clock::to_ns(histogram.max());
+}
\ No newline at end of file
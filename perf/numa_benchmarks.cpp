@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include "topology.hpp"
+
+#include <hqlockfree/mmap_allocator.hpp>
+#include <hqlockfree/numa.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+using hqlockfree::cache_size_policy;
+using hqlockfree::mmap_allocator;
+using hqlockfree::numa_placement;
+
+static constexpr size_t queue_size = 1024 << 4;
+
+using queue = hqlockfree::spsc_queue<uint64_t, cache_size_policy::pow2,
+                                     hqlockfree::no_stats,
+                                     mmap_allocator<uint64_t>>;
+
+/* -----------------------------------------------------------------------
+ *  Producer → consumer throughput with the ring and its cursors placed on
+ *  different nodes.
+ *
+ *  range(0) – cpu placement, as in spsc_benchmarks (label shows the nodes)
+ *  range(1) – memory placement:
+ *               0 first touch by the benchmark thread (the producer)
+ *               1 ring + cursors bound to the consumer's node
+ *               2 ring + cursors bound to the producer's node
+ *               3 ring interleaved across all nodes, cursors on consumer's
+ *
+ *  cursor_node reports where the queue object landed (-1 if the kernel will
+ *  not say) and numa_bound whether the ring was placed by mbind rather than
+ *  the first‑touch fallback.  On a single‑node machine all rows coincide.
+ * ---------------------------------------------------------------------*/
+
+enum class memory_placement { first_touch, consumer, producer, interleave };
+
+static void placement_matrix(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"placement", "memory"});
+    for (auto p : all_placements) {
+        if (!find_cpu_pair(p))
+            continue;
+        for (int64_t memory = 0; memory < 4; memory++)
+            b->Args({static_cast<int64_t>(p), memory});
+    }
+}
+
+static void numa_throughput(benchmark::State& st) {
+    const auto where = static_cast<placement>(st.range(0));
+    const auto cpus = *find_cpu_pair(where);
+    const auto memory = static_cast<memory_placement>(st.range(1));
+    st.SetLabel(describe(where, cpus));
+    scoped_pin pin(cpus.first);
+
+    const int producer_node = hqlockfree::numa_node_of_cpu(cpus.first);
+    const int consumer_node = hqlockfree::numa_node_of_cpu(cpus.second);
+
+    numa_placement data;
+    numa_placement cursors;
+    switch (memory) {
+    case memory_placement::first_touch:
+        break;
+    case memory_placement::consumer:
+        data = cursors = numa_placement::on_node(consumer_node);
+        break;
+    case memory_placement::producer:
+        data = cursors = numa_placement::on_node(producer_node);
+        break;
+    case memory_placement::interleave:
+        data = numa_placement::interleaved(0);
+        cursors = numa_placement::on_node(consumer_node);
+        break;
+    }
+
+    hqlockfree::mmap_options options;
+    options.huge_pages = false;
+    options.numa = data;
+    mmap_allocator<uint64_t> alloc(options);
+    hqlockfree::numa_placed<queue> q(cursors, 0, queue_size, alloc);
+
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+    std::thread consumer([&]() {
+        pin_current_thread(cpus.second);
+        started.test_and_set();
+        started.notify_all();
+        uint64_t next = 0;
+        uint64_t out = 0;
+        while (should_run.load(std::memory_order_relaxed)) {
+            if (q->pop(out) && out != (next++))
+                throw std::runtime_error("oops");
+        }
+    });
+    started.wait(false);
+
+    uint64_t iteration = 0;
+    for (auto _ : st) {
+        q->push(iteration++);
+    }
+
+    should_run = false;
+    if (consumer.joinable())
+        consumer.join();
+
+    st.counters["cursor_node"] = hqlockfree::numa_node_of(q.get());
+    st.counters["numa_bound"] = alloc.info().numa_bound;
+    st.SetItemsProcessed(st.iterations());
+}
+
+BENCHMARK(numa_throughput)->Apply(placement_matrix);
+
+BENCHMARK_MAIN();
\ No newline at end of file
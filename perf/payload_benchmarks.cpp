@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include "queue_wrappers.hpp"
+
+#include <hqlockfree/cache_utils.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+static constexpr size_t queue_size = 1024 << 2;
+
+using hqlockfree::cache_size_policy;
+
+/* -----------------------------------------------------------------------
+ *  payload<N> – N‑byte message with a sequence number up front
+ * ---------------------------------------------------------------------*/
+
+template <size_t bytes> struct payload {
+    uint64_t sequence;
+    std::array<std::byte, bytes - sizeof(uint64_t)> padding;
+};
+
+template <> struct payload<sizeof(uint64_t)> {
+    uint64_t sequence;
+};
+
+/* -----------------------------------------------------------------------
+ *  One producer pushing flat out, one consumer thread draining
+ * ---------------------------------------------------------------------*/
+
+template <queue_type type, cache_size_policy size_policy, size_t bytes>
+static void payload_throughput(benchmark::State& st) {
+    using element_type = payload<bytes>;
+    static_assert(sizeof(element_type) == bytes);
+
+    queue_wrapper<element_type, type, size_policy> q(queue_size);
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+
+    std::thread thread([&]() {
+        started.test_and_set();
+        started.notify_all();
+        uint64_t next = 0;
+        element_type out{};
+
+        while (should_run.load(std::memory_order_relaxed)) {
+            if (q.pop(out)) {
+                if (out.sequence != (next++)) {
+                    throw std::runtime_error("oops");
+                }
+            }
+            benchmark::DoNotOptimize(out);
+        }
+    });
+
+    started.wait(false);
+
+    element_type in{};
+    for (auto _ : st) {
+        q.push(in);
+        in.sequence++;
+    }
+
+    should_run = false;
+    if (thread.joinable())
+        thread.join();
+
+    /* Footprint of the ring relative to what the producer can actually
+     * fill: padding inside each line plus the one slot kept vacant. */
+    using line_type = hqlockfree::cache_line<element_type, size_policy>;
+    const size_t lines = q.capacity() / line_type::number_of_elements;
+    st.counters["elements_per_line"] = line_type::number_of_elements;
+    st.counters["buffer_bytes_per_slot"] =
+        double(lines * sizeof(line_type)) / double(q.capacity() - 1);
+
+    st.SetItemsProcessed(st.iterations());
+    st.SetBytesProcessed(st.iterations() * int64_t(bytes));
+}
+
+#define PAYLOAD_SWEEP(type, size_policy)                                       \
+    BENCHMARK(payload_throughput<type, size_policy, 8>);                       \
+    BENCHMARK(payload_throughput<type, size_policy, 16>);                      \
+    BENCHMARK(payload_throughput<type, size_policy, 24>);                      \
+    BENCHMARK(payload_throughput<type, size_policy, 48>);                      \
+    BENCHMARK(payload_throughput<type, size_policy, 64>);                      \
+    BENCHMARK(payload_throughput<type, size_policy, 96>);                      \
+    BENCHMARK(payload_throughput<type, size_policy, 256>);                     \
+    BENCHMARK(payload_throughput<type, size_policy, 1024>)
+
+PAYLOAD_SWEEP(queue_type::spsc, cache_size_policy::exact);
+PAYLOAD_SWEEP(queue_type::spsc, cache_size_policy::pow2);
+PAYLOAD_SWEEP(queue_type::mpsc, cache_size_policy::exact);
+PAYLOAD_SWEEP(queue_type::mpsc, cache_size_policy::pow2);
+PAYLOAD_SWEEP(queue_type::fanout, cache_size_policy::exact);
+PAYLOAD_SWEEP(queue_type::fanout, cache_size_policy::pow2);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* -----------------------------------------------------------------------
+ *  perf_counters – per‑thread hardware counters via perf_event_open
+ *
+ *  Opens cycles, instructions, branch misses, L1D, LLC and dTLB read misses
+ *  for the *calling* thread.  Model‑specific events (HITM, snoop responses…)
+ *  can be added as raw events through the environment:
+ *
+ *      HQLOCKFREE_PERF_EVENTS="hitm=0x04d2,snoop_hit=0x02d2"
+ *
+ *  Events the kernel or PMU refuses are silently dropped, so on a machine
+ *  without perf access (containers, perf_event_paranoid, VMs) the collector
+ *  simply reports nothing.  HQLOCKFREE_PERF_EVENTS=off disables it.
+ * ---------------------------------------------------------------------*/
+
+class perf_counters {
+  private:
+    struct event {
+        std::string name;
+        int fd;
+        double total;
+    };
+
+    std::vector<event> m_events;
+
+    static constexpr uint64_t cache_read_miss(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    void open(const std::string& name, uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        const int fd = static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd >= 0)
+            m_events.push_back(event{name, fd, 0});
+    }
+
+  public:
+    perf_counters() {
+        const char* env = std::getenv("HQLOCKFREE_PERF_EVENTS");
+        if (env && std::strcmp(env, "off") == 0)
+            return;
+
+        open("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open("branch_misses", PERF_TYPE_HARDWARE,
+             PERF_COUNT_HW_BRANCH_MISSES);
+        open("l1d_misses", PERF_TYPE_HW_CACHE,
+             cache_read_miss(PERF_COUNT_HW_CACHE_L1D));
+        open("llc_misses", PERF_TYPE_HW_CACHE,
+             cache_read_miss(PERF_COUNT_HW_CACHE_LL));
+        open("dtlb_misses", PERF_TYPE_HW_CACHE,
+             cache_read_miss(PERF_COUNT_HW_CACHE_DTLB));
+
+        if (env) {
+            std::stringstream ss(env);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                const auto eq = item.find('=');
+                if (eq == std::string::npos)
+                    continue;
+                open(item.substr(0, eq), PERF_TYPE_RAW,
+                     std::stoull(item.substr(eq + 1), nullptr, 0));
+            }
+        }
+    }
+
+    ~perf_counters() {
+        for (auto& e : m_events)
+            close(e.fd);
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    bool available() const { return !m_events.empty(); }
+
+    void start() {
+        for (auto& e : m_events) {
+            ioctl(e.fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(e.fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    /// @brief Stop counting and accumulate, scaling for multiplexing.
+    void stop() {
+        for (auto& e : m_events)
+            ioctl(e.fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (auto& e : m_events) {
+            uint64_t values[3] = {0, 0, 0}; // value, enabled, running
+            if (read(e.fd, values, sizeof(values)) != sizeof(values))
+                continue;
+            if (values[2] != 0)
+                e.total +=
+                    double(values[0]) * double(values[1]) / double(values[2]);
+        }
+    }
+
+    /// @brief Publish every counter as `<prefix><name>` averaged over the
+    /// benchmark's iterations.
+    void report(benchmark::State& st, const std::string& prefix) const {
+        for (const auto& e : m_events) {
+            st.counters[prefix + e.name] =
+                benchmark::Counter(e.total, benchmark::Counter::kAvgIterations);
+        }
+    }
+};
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/persistent_queue.hpp>
+
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* 2^24 slots of 64 bytes: a 1 GB ring, one message per cache line */
+static constexpr size_t ring_slots = size_t(1) << 24;
+
+struct message {
+    std::array<uint64_t, 8> fields{};
+};
+
+using file_queue = hqlockfree::persistent_mpsc_queue<message, ring_slots>;
+
+static std::filesystem::path ring_path() {
+    return std::filesystem::temp_directory_path() /
+           ("hqlockfree_restart." + std::to_string(getpid()));
+}
+
+/* -----------------------------------------------------------------------
+ *  Restart with range(0) messages queued: reopen the file and pop the first
+ *  one, against rebuilding a heap ring and replaying the backlog into it
+ *  (what a restart costs without persistence, minus the upstream fetch)
+ * ---------------------------------------------------------------------*/
+
+static void restart_reopen(benchmark::State& st) {
+    const auto backlog = static_cast<size_t>(st.range(0));
+    const auto path = ring_path();
+    std::filesystem::remove(path);
+    {
+        file_queue q(path);
+        message in;
+        for (size_t i = 0; i < backlog; i++) {
+            in.fields[0] = i;
+            q->push(in);
+        }
+    }
+
+    message out;
+    for (auto _ : st) {
+        file_queue q(path);
+        q->pop(out);
+        q->push(out); // keep the backlog for the next iteration
+        benchmark::DoNotOptimize(out);
+    }
+    std::filesystem::remove(path);
+    st.counters["ring_mb"] = double(sizeof(file_queue::queue_type) >> 20);
+}
+
+static void restart_replay(benchmark::State& st) {
+    const auto backlog = static_cast<size_t>(st.range(0));
+    std::vector<message> upstream(backlog);
+    for (size_t i = 0; i < backlog; i++)
+        upstream[i].fields[0] = i;
+
+    message out;
+    for (auto _ : st) {
+        auto q = std::make_unique<hqlockfree::mpsc_queue<message>>(0,
+                                                                   ring_slots);
+        q->push_n(upstream.data(), upstream.size());
+        q->pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+static void backlogs(benchmark::internal::Benchmark* b) {
+    b->ArgName("backlog")
+        ->RangeMultiplier(16)
+        ->Range(1 << 12, 1 << 20)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(restart_reopen)->Apply(backlogs);
+BENCHMARK(restart_replay)->Apply(backlogs);
+
+BENCHMARK_MAIN();
\ No newline at end of file
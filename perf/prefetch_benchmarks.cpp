@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include "queue_wrappers.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+/* Rings of 16 MB whatever the element size, so the consumer's next slots are
+ * not already in its cache and the prefetch has something to hide. */
+static constexpr size_t ring_bytes = size_t(16) << 20;
+
+template <size_t bytes> struct payload {
+    uint64_t sequence;
+    std::array<std::byte, bytes - sizeof(uint64_t)> padding;
+};
+
+template <> struct payload<sizeof(uint64_t)> {
+    uint64_t sequence;
+};
+
+/* -----------------------------------------------------------------------
+ *  One producer, one consumer; range(0) is the prefetch distance in slots
+ *  (0 = off), applied to both ends
+ * ---------------------------------------------------------------------*/
+
+template <queue_type type, size_t bytes>
+static void prefetch_throughput(benchmark::State& st) {
+    using element_type = payload<bytes>;
+    const auto distance = static_cast<size_t>(st.range(0));
+    queue_wrapper<element_type, type, hqlockfree::cache_size_policy::pow2,
+                  hqlockfree::tunable_prefetch>
+        q(ring_bytes / bytes);
+    q.prefetch().distance = distance;
+    if constexpr (type == queue_type::fanout)
+        q.sub->prefetch().distance = distance;
+
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+    std::thread consumer([&]() {
+        started.test_and_set();
+        started.notify_all();
+        uint64_t next = 0;
+        element_type out{};
+        while (should_run.load(std::memory_order_relaxed)) {
+            if (q.pop(out) && out.sequence != (next++))
+                throw std::runtime_error("oops");
+        }
+    });
+    started.wait(false);
+
+    element_type in{};
+    for (auto _ : st) {
+        q.push(in);
+        in.sequence++;
+    }
+
+    should_run = false;
+    if (consumer.joinable())
+        consumer.join();
+
+    st.SetItemsProcessed(st.iterations());
+    st.SetBytesProcessed(st.iterations() * int64_t(bytes));
+}
+
+static void distances(benchmark::internal::Benchmark* b) {
+    b->ArgName("distance");
+    for (int64_t d : {0, 1, 2, 4, 8, 16, 32})
+        b->Arg(d);
+}
+
+#define PREFETCH_SWEEP(type)                                                   \
+    BENCHMARK(prefetch_throughput<type, 8>)->Apply(distances);                 \
+    BENCHMARK(prefetch_throughput<type, 64>)->Apply(distances);                \
+    BENCHMARK(prefetch_throughput<type, 256>)->Apply(distances)
+
+PREFETCH_SWEEP(queue_type::spsc);
+PREFETCH_SWEEP(queue_type::mpsc);
+PREFETCH_SWEEP(queue_type::fanout);
+
+BENCHMARK_MAIN();
\ No newline at end of file
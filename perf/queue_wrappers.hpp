@@ -0,0 +1,119 @@
+#pragma once
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <hqlockfree/mpmc_fanout.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <memory>
+#include <mutex>
+#include <queue>
+
+/* Uniform push/pop facade over the hqlockfree containers and the baselines
+ * they are compared against.  Shared by every benchmark in perf/. */
+
+enum class queue_type { spsc, mpsc, fanout, boost_spsc, boost_mpsc, mutex };
+
+/* `size_policy` and `prefetch_policy` only apply to the hqlockfree
+ * containers; the baselines ignore them. */
+template <typename T, queue_type type,
+          hqlockfree::cache_size_policy size_policy =
+              hqlockfree::cache_size_policy::pow2,
+          typename prefetch_policy = hqlockfree::no_prefetch>
+struct queue_wrapper {};
+
+/// @brief The hqlockfree alias @p queue with the wrapper's policies.
+template <template <typename, hqlockfree::cache_size_policy, typename,
+                    typename, size_t, typename> class queue,
+          typename T, hqlockfree::cache_size_policy size_policy,
+          typename prefetch_policy>
+using wrapped_queue =
+    queue<T, size_policy, hqlockfree::no_stats, std::allocator<T>,
+          hqlockfree::destructive_interference_size, prefetch_policy>;
+
+template <typename T, hqlockfree::cache_size_policy size_policy,
+          typename prefetch_policy>
+struct queue_wrapper<T, queue_type::spsc, size_policy, prefetch_policy>
+    : public wrapped_queue<hqlockfree::spsc_queue, T, size_policy,
+                           prefetch_policy> {
+    explicit queue_wrapper(size_t n_elements)
+        : wrapped_queue<hqlockfree::spsc_queue, T, size_policy,
+                        prefetch_policy>(0, n_elements) {}
+};
+
+template <typename T, hqlockfree::cache_size_policy size_policy,
+          typename prefetch_policy>
+struct queue_wrapper<T, queue_type::mpsc, size_policy, prefetch_policy>
+    : public wrapped_queue<hqlockfree::mpsc_queue, T, size_policy,
+                           prefetch_policy> {
+    explicit queue_wrapper(size_t n_elements)
+        : wrapped_queue<hqlockfree::mpsc_queue, T, size_policy,
+                        prefetch_policy>(0, n_elements) {}
+};
+
+template <typename T, hqlockfree::cache_size_policy size_policy,
+          typename prefetch_policy>
+struct queue_wrapper<T, queue_type::fanout, size_policy, prefetch_policy>
+    : public wrapped_queue<hqlockfree::mpmc_fanout, T, size_policy,
+                           prefetch_policy> {
+    using fanout = wrapped_queue<hqlockfree::mpmc_fanout, T, size_policy,
+                                 prefetch_policy>;
+    std::shared_ptr<typename fanout::subscription_handle> sub;
+    explicit queue_wrapper(size_t n_elements)
+        : fanout(0, n_elements), sub(this->subscribe()) {}
+
+    bool pop(T& value) { return sub->pop(value); }
+};
+
+template <typename T, hqlockfree::cache_size_policy size_policy,
+          typename prefetch_policy>
+struct queue_wrapper<T, queue_type::boost_mpsc, size_policy, prefetch_policy> {
+    boost::lockfree::queue<T> queue;
+    explicit queue_wrapper(size_t n_elements) : queue(n_elements) {}
+
+    void push(const T& value) {
+        while (!queue.push(value)) {
+        }
+    }
+
+    bool pop(T& value) { return queue.pop(value); }
+};
+
+template <typename T, hqlockfree::cache_size_policy size_policy,
+          typename prefetch_policy>
+struct queue_wrapper<T, queue_type::boost_spsc, size_policy, prefetch_policy> {
+    boost::lockfree::spsc_queue<T> queue;
+    explicit queue_wrapper(size_t n_elements) : queue(n_elements) {}
+
+    void push(const T& value) {
+        while (!queue.push(value)) {
+        }
+    }
+
+    bool pop(T& value) { return queue.pop(value); }
+};
+
+template <typename T, hqlockfree::cache_size_policy size_policy,
+          typename prefetch_policy>
+struct queue_wrapper<T, queue_type::mutex, size_policy, prefetch_policy> {
+    explicit queue_wrapper([[maybe_unused]] size_t n_elements) {}
+    std::queue<T> queue;
+    std::mutex mutex;
+    void push(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(value);
+    }
+    void push(T&& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(std::move(value));
+    }
+    bool pop(T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() == 0)
+            return false;
+        value = queue.front();
+        queue.pop();
+        return true;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include <benchmark/benchmark.h>
+
+#include "latency_utils.hpp"
+
+#include <hqlockfree/spmc_push_vec.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static constexpr size_t initial_capacity = 256;
+static constexpr size_t read_set_size = 1 << 16;
+
+enum class vec_type { push_vec, shared_mutex_vector, mutex_deque };
+
+/* -----------------------------------------------------------------------
+ *  Uniform facade: one producer appending, many readers
+ * ---------------------------------------------------------------------*/
+
+template <typename T, vec_type type> struct vec_wrapper {};
+
+template <typename T> struct vec_wrapper<T, vec_type::push_vec> {
+    hqlockfree::spmc_push_vec<T> vec{initial_capacity};
+
+    void push_back(const T& value) { vec.push_back(value); }
+    void emplace_back(const T& value) { vec.emplace_back(value); }
+    size_t size() const { return vec.size(); }
+    T read(size_t idx) const { return vec[idx]; }
+    T sum() const {
+        T out = 0;
+        for (const auto& v : vec)
+            out += v;
+        return out;
+    }
+    size_t retained_bytes() const {
+        return vec.retained_capacity() * sizeof(T);
+    }
+};
+
+template <typename T> struct vec_wrapper<T, vec_type::shared_mutex_vector> {
+    std::vector<T> vec;
+    mutable std::shared_mutex mutex;
+
+    vec_wrapper() { vec.reserve(initial_capacity); }
+
+    void push_back(const T& value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        vec.push_back(value);
+    }
+    void emplace_back(const T& value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        vec.emplace_back(value);
+    }
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return vec.size();
+    }
+    T read(size_t idx) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return vec[idx];
+    }
+    T sum() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        T out = 0;
+        for (const auto& v : vec)
+            out += v;
+        return out;
+    }
+    size_t retained_bytes() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return vec.capacity() * sizeof(T);
+    }
+};
+
+template <typename T> struct vec_wrapper<T, vec_type::mutex_deque> {
+    std::deque<T> vec;
+    mutable std::mutex mutex;
+
+    void push_back(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        vec.push_back(value);
+    }
+    void emplace_back(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        vec.emplace_back(value);
+    }
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return vec.size();
+    }
+    T read(size_t idx) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return vec[idx];
+    }
+    T sum() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        T out = 0;
+        for (const auto& v : vec)
+            out += v;
+        return out;
+    }
+    size_t retained_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return vec.size() * sizeof(T);
+    }
+};
+
+/* -----------------------------------------------------------------------
+ *  Producer: per‑call push_back / emplace_back latency, growth spikes
+ *  included.  range(0) readers scan the container concurrently.
+ * ---------------------------------------------------------------------*/
+
+template <vec_type type, bool emplace>
+static void append_latency(benchmark::State& st) {
+    const auto n_readers = static_cast<size_t>(st.range(0));
+    vec_wrapper<uint64_t, type> vec;
+    latency_histogram<> histogram;
+    std::atomic<bool> should_run = true;
+
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < n_readers; r++) {
+        readers.emplace_back([&]() {
+            while (should_run.load(std::memory_order_relaxed)) {
+                benchmark::DoNotOptimize(vec.sum());
+            }
+        });
+    }
+
+    uint64_t value = 0;
+    for (auto _ : st) {
+        const uint64_t start = tsc_clock::now();
+        if constexpr (emplace) {
+            vec.emplace_back(value++);
+        } else {
+            vec.push_back(value++);
+        }
+        histogram.record_single_writer(tsc_clock::now() - start);
+    }
+
+    should_run = false;
+    for (auto& t : readers)
+        t.join();
+
+    st.SetItemsProcessed(st.iterations());
+    report_latency(st, histogram);
+    st.counters["retained_bytes_per_element"] =
+        double(vec.retained_bytes()) / double(vec.size());
+}
+
+/* -----------------------------------------------------------------------
+ *  Readers: benchmark threads share one pre‑filled container while a
+ *  background producer keeps appending to it.
+ * ---------------------------------------------------------------------*/
+
+template <vec_type type> struct shared_fixture {
+    static inline std::unique_ptr<vec_wrapper<uint64_t, type>> vec;
+    static inline std::atomic<bool> should_run;
+    static inline std::thread producer;
+
+    static void setup(benchmark::State& st) {
+        if (st.thread_index() != 0)
+            return;
+        vec = std::make_unique<vec_wrapper<uint64_t, type>>();
+        for (uint64_t i = 0; i < read_set_size; i++)
+            vec->push_back(i);
+        should_run = true;
+        producer = std::thread([]() {
+            uint64_t value = read_set_size;
+            /* bounded so long runs do not grow without limit */
+            while (should_run.load(std::memory_order_relaxed) &&
+                   value < 64 * read_set_size) {
+                vec->push_back(value++);
+            }
+        });
+    }
+
+    static void teardown(benchmark::State& st) {
+        if (st.thread_index() != 0)
+            return;
+        should_run = false;
+        producer.join();
+        vec.reset();
+    }
+};
+
+template <vec_type type> static void random_read(benchmark::State& st) {
+    using fixture = shared_fixture<type>;
+    fixture::setup(st);
+
+    uint64_t rng = 0x9E3779B97F4A7C15ULL * uint64_t(st.thread_index() + 1);
+    for (auto _ : st) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        const size_t idx = rng & (read_set_size - 1);
+        if (fixture::vec->read(idx) != idx) {
+            throw std::runtime_error("oops");
+        }
+    }
+
+    fixture::teardown(st);
+    st.SetItemsProcessed(st.iterations());
+}
+
+template <vec_type type> static void scan(benchmark::State& st) {
+    using fixture = shared_fixture<type>;
+    fixture::setup(st);
+
+    int64_t elements = 0;
+    for (auto _ : st) {
+        benchmark::DoNotOptimize(fixture::vec->sum());
+        elements += int64_t(fixture::vec->size());
+    }
+
+    fixture::teardown(st);
+    st.SetItemsProcessed(elements);
+}
+
+static void reader_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("readers")->Arg(0)->Arg(1)->Arg(4);
+}
+
+BENCHMARK(append_latency<vec_type::push_vec, false>)->Apply(reader_args);
+BENCHMARK(append_latency<vec_type::shared_mutex_vector, false>)
+    ->Apply(reader_args);
+BENCHMARK(append_latency<vec_type::mutex_deque, false>)->Apply(reader_args);
+BENCHMARK(append_latency<vec_type::push_vec, true>)->Apply(reader_args);
+BENCHMARK(append_latency<vec_type::shared_mutex_vector, true>)
+    ->Apply(reader_args);
+BENCHMARK(append_latency<vec_type::mutex_deque, true>)->Apply(reader_args);
+
+BENCHMARK(random_read<vec_type::push_vec>)->ThreadRange(1, 32);
+BENCHMARK(random_read<vec_type::shared_mutex_vector>)->ThreadRange(1, 32);
+BENCHMARK(random_read<vec_type::mutex_deque>)->ThreadRange(1, 32);
+
+BENCHMARK(scan<vec_type::push_vec>)->ThreadRange(1, 32);
+BENCHMARK(scan<vec_type::shared_mutex_vector>)->ThreadRange(1, 32);
+BENCHMARK(scan<vec_type::mutex_deque>)->ThreadRange(1, 32);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -1,103 +1,45 @@
 #include <benchmark/benchmark.h>
 
-#include <boost/lockfree/queue.hpp>
-#include <boost/lockfree/spsc_queue.hpp>
-#include <hqlockfree/mpmc_fanout.hpp>
-#include <hqlockfree/mpsc_queue.hpp>
-#include <hqlockfree/spsc_queue.hpp>
+#include "perf_counters.hpp"
+#include "queue_wrappers.hpp"
+#include "topology.hpp"
 
 #include <atomic>
 #include <memory>
-#include <mutex>
-#include <queue>
 #include <thread>
 
 static constexpr size_t queue_size = 1024 << 4;
 
-enum class queue_type { spsc, mpsc, fanout, boost_spsc, boost_mpsc, mutex };
-
-template <typename T, queue_type type> struct queue_wrapper {};
-
-template <typename T>
-struct queue_wrapper<T, queue_type::spsc> : public hqlockfree::spsc_queue<T> {
-    explicit queue_wrapper(size_t n_elements)
-        : hqlockfree::spsc_queue<T>(0, n_elements) {}
-};
-
-template <typename T>
-struct queue_wrapper<T, queue_type::mpsc> : public hqlockfree::mpsc_queue<T> {
-    explicit queue_wrapper(size_t n_elements)
-        : hqlockfree::mpsc_queue<T>(0, n_elements) {}
-};
-
-template <typename T>
-struct queue_wrapper<T, queue_type::fanout>
-    : public hqlockfree::mpmc_fanout<T> {
-    std::shared_ptr<typename hqlockfree::mpmc_fanout<T>::subscription_handle>
-        sub;
-    explicit queue_wrapper(size_t n_elements)
-        : hqlockfree::mpmc_fanout<T>(0, n_elements), sub(this->subscribe()) {}
-
-    bool pop(T& value) { return sub->pop(value); }
-};
-
-template <typename T> struct queue_wrapper<T, queue_type::boost_mpsc> {
-    boost::lockfree::queue<T> queue;
-    explicit queue_wrapper(size_t n_elements) : queue(n_elements) {}
-
-    void push(const T& value) {
-        while (!queue.push(value)) {
-        }
+/* range(0) selects where the producer (benchmark thread) and consumer run,
+ * see topology.hpp; only placements this machine can provide are run. */
+static void placement_matrix(benchmark::internal::Benchmark* b) {
+    b->ArgName("placement");
+    for (auto p : all_placements) {
+        if (find_cpu_pair(p))
+            b->Arg(static_cast<int64_t>(p));
     }
-
-    bool pop(T& value) { return queue.pop(value); }
-};
-
-template <typename T> struct queue_wrapper<T, queue_type::boost_spsc> {
-    boost::lockfree::spsc_queue<T> queue;
-    explicit queue_wrapper(size_t n_elements) : queue(n_elements) {}
-
-    void push(const T& value) {
-        while (!queue.push(value)) {
-        }
-    }
-
-    bool pop(T& value) { return queue.pop(value); }
-};
-
-template <typename T> struct queue_wrapper<T, queue_type::mutex> {
-    explicit queue_wrapper([[maybe_unused]] size_t n_elements) {}
-    std::queue<T> queue;
-    std::mutex mutex;
-    void push(const T& value) {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(value);
-    }
-    void push(T&& value) {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(std::move(value));
-    }
-    bool pop(T& value) {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (queue.size() == 0)
-            return false;
-        value = queue.front();
-        queue.pop();
-        return true;
-    }
-};
+}
 
 template <queue_type type>
 static void callsite_push_latency_single_producer(benchmark::State& st) {
+    const auto where = static_cast<placement>(st.range(0));
+    const auto cpus = *find_cpu_pair(where);
+    st.SetLabel(describe(where, cpus));
+    scoped_pin pin(cpus.first);
+
     queue_wrapper<size_t, type> q(queue_size);
     std::atomic<bool> should_run = true;
     std::atomic_flag started = false;
+    std::unique_ptr<perf_counters> pop_counters;
 
     std::thread thread([&]() {
+        pin_current_thread(cpus.second);
+        pop_counters = std::make_unique<perf_counters>();
         started.test_and_set();
         started.notify_all();
         size_t next = 0;
 
+        pop_counters->start();
         while (should_run.load(std::memory_order_relaxed)) {
             size_t out = 0;
             bool popped = q.pop(out);
@@ -109,43 +51,62 @@ static void callsite_push_latency_single_producer(benchmark::State& st) {
             benchmark::DoNotOptimize(popped);
             benchmark::DoNotOptimize(out);
         }
+        pop_counters->stop();
     });
 
     started.wait(false);
 
+    perf_counters push_counters;
+    push_counters.start();
     size_t iteration = 0;
     for (auto _ : st) {
         q.push(iteration++);
     }
+    push_counters.stop();
 
     should_run = false;
     if (thread.joinable())
         thread.join();
 
+    /* consumer figures include its empty polls: cost per element delivered */
+    push_counters.report(st, "push_");
+    pop_counters->report(st, "pop_");
     st.SetItemsProcessed(st.iterations());
 }
 
 template <queue_type type>
 static void roundtrip_single_producer(benchmark::State& st) {
+    const auto where = static_cast<placement>(st.range(0));
+    const auto cpus = *find_cpu_pair(where);
+    st.SetLabel(describe(where, cpus));
+    scoped_pin pin(cpus.first);
+
     queue_wrapper<size_t, type> q1(queue_size);
     queue_wrapper<size_t, type> q2(queue_size);
     std::atomic<bool> should_run = true;
     std::atomic_flag started = false;
+    std::unique_ptr<perf_counters> echo_counters;
 
     std::thread thread([&]() {
+        pin_current_thread(cpus.second);
+        echo_counters = std::make_unique<perf_counters>();
         started.test_and_set();
         started.notify_all();
 
+        echo_counters->start();
         while (should_run.load(std::memory_order_relaxed)) {
             size_t out = 0;
             if (q1.pop(out)) {
                 q2.push(out);
             }
         }
+        echo_counters->stop();
     });
 
     started.wait(false);
 
+    perf_counters roundtrip_counters;
+    roundtrip_counters.start();
     size_t iteration = 0;
     for (auto _ : st) {
         const size_t to_send = iteration++;
@@ -157,18 +118,29 @@ static void roundtrip_single_producer(benchmark::State& st) {
             throw std::runtime_error("oops");
         }
     }
+    roundtrip_counters.stop();
 
     should_run = false;
     if (thread.joinable())
         thread.join();
 
+    roundtrip_counters.report(st, "producer_");
+    echo_counters->report(st, "echo_");
     st.SetItemsProcessed(st.iterations());
 }
 
-template <queue_type type>
+/* `prefetch_policy` lets the rows below compare the default queue with one
+ * carrying a run-time prefetch distance left at 0: the price of the option
+ * when it is off. */
+template <queue_type type,
+          typename prefetch_policy = hqlockfree::no_prefetch>
 static void roundtrip_single_thread(benchmark::State& st) {
-    queue_wrapper<size_t, type> q1(queue_size);
+    queue_wrapper<size_t, type, hqlockfree::cache_size_policy::pow2,
+                  prefetch_policy>
+        q1(queue_size);
 
+    perf_counters counters;
+    counters.start();
     size_t iteration = 0;
     for (auto _ : st) {
         const size_t to_send = iteration++;
@@ -179,29 +151,50 @@ static void roundtrip_single_thread(benchmark::State& st) {
             throw std::runtime_error("oops");
         }
     }
+    counters.stop();
 
+    counters.report(st, "");
     st.SetItemsProcessed(st.iterations());
 }
 
-BENCHMARK(callsite_push_latency_single_producer<queue_type::spsc>)->Args({});
-BENCHMARK(callsite_push_latency_single_producer<queue_type::mpsc>)->Args({});
-BENCHMARK(callsite_push_latency_single_producer<queue_type::fanout>)->Args({});
+BENCHMARK(callsite_push_latency_single_producer<queue_type::spsc>)
+    ->Apply(placement_matrix);
+BENCHMARK(callsite_push_latency_single_producer<queue_type::mpsc>)
+    ->Apply(placement_matrix);
+BENCHMARK(callsite_push_latency_single_producer<queue_type::fanout>)
+    ->Apply(placement_matrix);
 BENCHMARK(callsite_push_latency_single_producer<queue_type::boost_spsc>)
-    ->Args({});
+    ->Apply(placement_matrix);
 BENCHMARK(callsite_push_latency_single_producer<queue_type::boost_mpsc>)
-    ->Args({});
-BENCHMARK(callsite_push_latency_single_producer<queue_type::mutex>)->Args({});
-
-BENCHMARK(roundtrip_single_producer<queue_type::spsc>)->Args({});
-BENCHMARK(roundtrip_single_producer<queue_type::mpsc>)->Args({});
-BENCHMARK(roundtrip_single_producer<queue_type::fanout>)->Args({});
-BENCHMARK(roundtrip_single_producer<queue_type::boost_spsc>)->Args({});
-BENCHMARK(roundtrip_single_producer<queue_type::boost_mpsc>)->Args({});
-BENCHMARK(roundtrip_single_producer<queue_type::mutex>)->Args({});
+    ->Apply(placement_matrix);
+BENCHMARK(callsite_push_latency_single_producer<queue_type::mutex>)
+    ->Apply(placement_matrix);
+
+BENCHMARK(roundtrip_single_producer<queue_type::spsc>)
+    ->Apply(placement_matrix);
+BENCHMARK(roundtrip_single_producer<queue_type::mpsc>)
+    ->Apply(placement_matrix);
+BENCHMARK(roundtrip_single_producer<queue_type::fanout>)
+    ->Apply(placement_matrix);
+BENCHMARK(roundtrip_single_producer<queue_type::boost_spsc>)
+    ->Apply(placement_matrix);
+BENCHMARK(roundtrip_single_producer<queue_type::boost_mpsc>)
+    ->Apply(placement_matrix);
+BENCHMARK(roundtrip_single_producer<queue_type::mutex>)
+    ->Apply(placement_matrix);
 
 BENCHMARK(roundtrip_single_thread<queue_type::spsc>)->Args({});
+BENCHMARK_TEMPLATE(roundtrip_single_thread, queue_type::spsc,
+                   hqlockfree::tunable_prefetch)
+    ->Args({});
 BENCHMARK(roundtrip_single_thread<queue_type::mpsc>)->Args({});
+BENCHMARK_TEMPLATE(roundtrip_single_thread, queue_type::mpsc,
+                   hqlockfree::tunable_prefetch)
+    ->Args({});
 BENCHMARK(roundtrip_single_thread<queue_type::fanout>)->Args({});
+BENCHMARK_TEMPLATE(roundtrip_single_thread, queue_type::fanout,
+                   hqlockfree::tunable_prefetch)
+    ->Args({});
 BENCHMARK(roundtrip_single_thread<queue_type::boost_spsc>)->Args({});
 BENCHMARK(roundtrip_single_thread<queue_type::boost_mpsc>)->Args({});
 BENCHMARK(roundtrip_single_thread<queue_type::mutex>)->Args({});
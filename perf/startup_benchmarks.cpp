@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/cache_utils.hpp>
+#include <hqlockfree/mpmc_fanout.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using hqlockfree::cache_size_policy;
+
+/* -----------------------------------------------------------------------
+ *  Element types: trivially constructible, and one whose constructor does
+ *  real work (here: filling a 64‑byte order book level)
+ * ---------------------------------------------------------------------*/
+
+struct expensive {
+    std::array<uint64_t, 8> fields;
+    expensive() {
+        for (size_t i = 0; i < fields.size(); i++)
+            fields[i] = i * 0x9e3779b97f4a7c15ULL;
+    }
+};
+
+/* The rings start uninitialised, so construction should cost the same for
+ * both types and stay flat in the ring size until the storage is touched.
+ * `eager` builds what the buffer used to: a vector of constructed lines, one
+ * default‑constructed T per slot. */
+
+enum class container { eager, spsc, mpsc, fanout };
+
+template <container which, typename T>
+static void ring_construction(benchmark::State& st) {
+    const auto slots = static_cast<size_t>(st.range(0));
+    for (auto _ : st) {
+        if constexpr (which == container::eager) {
+            using line = hqlockfree::cache_line<T, cache_size_policy::pow2>;
+            std::vector<line> lines(slots / line::number_of_elements);
+            benchmark::DoNotOptimize(lines.data());
+        } else if constexpr (which == container::spsc) {
+            auto q = std::make_unique<hqlockfree::spsc_queue<T>>(0, slots);
+            benchmark::DoNotOptimize(q.get());
+        } else if constexpr (which == container::mpsc) {
+            auto q = std::make_unique<hqlockfree::mpsc_queue<T>>(0, slots);
+            benchmark::DoNotOptimize(q.get());
+        } else {
+            auto q = std::make_unique<hqlockfree::mpmc_fanout<T>>(0, slots);
+            benchmark::DoNotOptimize(q.get());
+        }
+    }
+    st.counters["slots"] = double(slots);
+}
+
+static void ring_sizes(benchmark::internal::Benchmark* b) {
+    b->ArgName("slots")
+        ->RangeMultiplier(16)
+        ->Range(1 << 12, 1 << 20)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+#define STARTUP_SWEEP(T)                                                       \
+    BENCHMARK(ring_construction<container::eager, T>)->Apply(ring_sizes);      \
+    BENCHMARK(ring_construction<container::spsc, T>)->Apply(ring_sizes);       \
+    BENCHMARK(ring_construction<container::mpsc, T>)->Apply(ring_sizes);       \
+    BENCHMARK(ring_construction<container::fanout, T>)->Apply(ring_sizes)
+
+STARTUP_SWEEP(uint64_t);
+STARTUP_SWEEP(expensive);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/mpmc_fanout.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/queue_stats.hpp>
+#include <hqlockfree/sojourn_sampler.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+static constexpr size_t queue_size = 1024 << 4;
+
+using hqlockfree::cache_size_policy;
+using hqlockfree::no_stats;
+using hqlockfree::queue_stats;
+using sampler = hqlockfree::sojourn_sampler<64>;
+
+/* The no‑op policy must not change the layout of any queue... */
+static_assert(std::is_empty_v<no_stats>);
+static_assert(sizeof(hqlockfree::spsc_queue<uint64_t>) ==
+              sizeof(hqlockfree::spsc_queue<uint64_t, cache_size_policy::pow2,
+                                            no_stats>));
+
+/* ...and the benchmarks below show it does not change the hot paths either:
+ * `no_stats` rows should match the default‑policy rows of spsc_benchmarks,
+ * `queue_stats` rows show what counting costs and `sampler` rows what 1‑in‑64
+ * sojourn sampling costs. */
+
+enum class queue_type { spsc, mpsc, fanout };
+
+template <queue_type type, typename stats_policy> struct queue_of {};
+
+template <typename stats_policy>
+struct queue_of<queue_type::spsc, stats_policy>
+    : hqlockfree::spsc_queue<uint64_t, cache_size_policy::pow2,
+                             stats_policy> {
+    queue_of()
+        : hqlockfree::spsc_queue<uint64_t, cache_size_policy::pow2,
+                                 stats_policy>(0, queue_size) {}
+};
+
+template <typename stats_policy>
+struct queue_of<queue_type::mpsc, stats_policy>
+    : hqlockfree::mpsc_queue<uint64_t, cache_size_policy::pow2,
+                             stats_policy> {
+    queue_of()
+        : hqlockfree::mpsc_queue<uint64_t, cache_size_policy::pow2,
+                                 stats_policy>(0, queue_size) {}
+};
+
+template <typename stats_policy>
+struct queue_of<queue_type::fanout, stats_policy>
+    : hqlockfree::mpmc_fanout<uint64_t, cache_size_policy::pow2,
+                              stats_policy> {
+    using base = hqlockfree::mpmc_fanout<uint64_t, cache_size_policy::pow2,
+                                         stats_policy>;
+    std::shared_ptr<typename base::subscription_handle> sub;
+    queue_of() : base(0, queue_size), sub(this->subscribe()) {}
+    bool pop(uint64_t& value) { return sub->pop(value); }
+};
+
+template <queue_type type, typename stats_policy>
+static void stats_roundtrip_single_thread(benchmark::State& st) {
+    queue_of<type, stats_policy> q;
+
+    uint64_t iteration = 0;
+    for (auto _ : st) {
+        const uint64_t to_send = iteration++;
+        q.push(to_send);
+        uint64_t to_recv = 0;
+        q.pop(to_recv);
+        if (to_recv != to_send) {
+            throw std::runtime_error("oops");
+        }
+    }
+
+    st.SetItemsProcessed(st.iterations());
+}
+
+template <queue_type type, typename stats_policy>
+static void stats_push_single_producer(benchmark::State& st) {
+    queue_of<type, stats_policy> q;
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+
+    std::thread thread([&]() {
+        started.test_and_set();
+        started.notify_all();
+        uint64_t out = 0;
+        while (should_run.load(std::memory_order_relaxed)) {
+            benchmark::DoNotOptimize(q.pop(out));
+        }
+    });
+
+    started.wait(false);
+
+    uint64_t iteration = 0;
+    for (auto _ : st) {
+        q.push(iteration++);
+    }
+
+    should_run = false;
+    if (thread.joinable())
+        thread.join();
+
+    if constexpr (std::is_same_v<stats_policy, queue_stats>) {
+        const auto snap = q.stats().snapshot();
+        st.counters["full_waits"] = double(snap.full_waits);
+        st.counters["empty_pops"] = double(snap.empty_pops);
+        st.counters["cas_failures"] = double(snap.cas_failures);
+        st.counters["high_water_mark"] = double(snap.high_water_mark);
+    }
+    if constexpr (std::is_same_v<stats_policy, sampler>) {
+        const auto& sojourn = q.stats().sojourn();
+        st.counters["samples"] = double(sojourn.count());
+        st.counters["p50_ns"] =
+            hqlockfree::tsc_clock::to_ns(sojourn.percentile(0.50));
+        st.counters["p99_ns"] =
+            hqlockfree::tsc_clock::to_ns(sojourn.percentile(0.99));
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+BENCHMARK(stats_roundtrip_single_thread<queue_type::spsc, no_stats>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::spsc, queue_stats>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::spsc, sampler>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::mpsc, no_stats>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::mpsc, queue_stats>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::mpsc, sampler>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::fanout, no_stats>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::fanout, queue_stats>);
+BENCHMARK(stats_roundtrip_single_thread<queue_type::fanout, sampler>);
+
+BENCHMARK(stats_push_single_producer<queue_type::spsc, no_stats>);
+BENCHMARK(stats_push_single_producer<queue_type::spsc, queue_stats>);
+BENCHMARK(stats_push_single_producer<queue_type::spsc, sampler>);
+BENCHMARK(stats_push_single_producer<queue_type::mpsc, no_stats>);
+BENCHMARK(stats_push_single_producer<queue_type::mpsc, queue_stats>);
+BENCHMARK(stats_push_single_producer<queue_type::mpsc, sampler>);
+BENCHMARK(stats_push_single_producer<queue_type::fanout, no_stats>);
+BENCHMARK(stats_push_single_producer<queue_type::fanout, queue_stats>);
+BENCHMARK(stats_push_single_producer<queue_type::fanout, sampler>);
+
+BENCHMARK_MAIN();
\ No newline at end of file
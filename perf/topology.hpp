@@ -0,0 +1,132 @@
+#pragma once
+
+#include <hqlockfree/cpu_topology.hpp>
+#include <hqlockfree/numa.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* -----------------------------------------------------------------------
+ *  CPU topology as reported by /sys/devices/system/cpu (library helpers)
+ * ---------------------------------------------------------------------*/
+
+using hqlockfree::cpu_info;
+using hqlockfree::pin_current_thread;
+using hqlockfree::read_cpu_topology;
+
+/* -----------------------------------------------------------------------
+ *  Producer / consumer placements
+ * ---------------------------------------------------------------------*/
+
+enum class placement {
+    unpinned,     ///< leave it to the scheduler
+    smt_siblings, ///< two hyper‑threads of one physical core
+    same_llc,     ///< separate physical cores sharing the last‑level cache
+    cross_llc,    ///< separate LLC domains (CCXs) within one socket
+    cross_socket, ///< different packages
+};
+
+static constexpr placement all_placements[] = {
+    placement::unpinned, placement::smt_siblings, placement::same_llc,
+    placement::cross_llc, placement::cross_socket};
+
+inline const char* to_string(placement p) {
+    switch (p) {
+    case placement::unpinned:
+        return "unpinned";
+    case placement::smt_siblings:
+        return "smt_siblings";
+    case placement::same_llc:
+        return "same_llc";
+    case placement::cross_llc:
+        return "cross_llc";
+    case placement::cross_socket:
+        return "cross_socket";
+    }
+    return "unknown";
+}
+
+/// @brief First (producer, consumer) cpu pair matching @p p, if the
+/// machine has one.  `unpinned` yields {-1, -1}.
+inline std::optional<std::pair<int, int>> find_cpu_pair(placement p) {
+    if (p == placement::unpinned)
+        return std::pair{-1, -1};
+    static const auto cpus = read_cpu_topology();
+    for (const auto& a : cpus) {
+        for (const auto& b : cpus) {
+            if (a.cpu == b.cpu)
+                continue;
+            const bool same_package = a.package == b.package;
+            const bool same_core = same_package && a.core == b.core;
+            const bool same_llc = a.llc == b.llc;
+            bool match = false;
+            switch (p) {
+            case placement::unpinned:
+                break;
+            case placement::smt_siblings:
+                match = same_core;
+                break;
+            case placement::same_llc:
+                match = !same_core && same_llc;
+                break;
+            case placement::cross_llc:
+                match = same_package && !same_llc;
+                break;
+            case placement::cross_socket:
+                match = !same_package;
+                break;
+            }
+            if (match)
+                return std::pair{a.cpu, b.cpu};
+        }
+    }
+    return std::nullopt;
+}
+
+/// @brief Benchmark label, e.g. "same_llc cpu2->cpu4 node0->node0".
+inline std::string describe(placement p, std::pair<int, int> cpus) {
+    std::string out = to_string(p);
+    if (cpus.first >= 0) {
+        out += " cpu" + std::to_string(cpus.first) + "->cpu" +
+               std::to_string(cpus.second);
+        out += " node" +
+               std::to_string(hqlockfree::numa_node_of_cpu(cpus.first)) +
+               "->node" +
+               std::to_string(hqlockfree::numa_node_of_cpu(cpus.second));
+    }
+    return out;
+}
+
+/* -----------------------------------------------------------------------
+ *  Thread pinning
+ * ---------------------------------------------------------------------*/
+
+/// @brief Pin the calling thread for the lifetime of the object, restoring
+/// its previous affinity afterwards.
+class scoped_pin {
+  private:
+    cpu_set_t m_previous;
+    bool m_restore = false;
+
+  public:
+    explicit scoped_pin(int cpu) {
+        if (cpu < 0)
+            return;
+        m_restore = pthread_getaffinity_np(pthread_self(), sizeof(m_previous),
+                                           &m_previous) == 0;
+        pin_current_thread(cpu);
+    }
+    ~scoped_pin() {
+        if (m_restore)
+            pthread_setaffinity_np(pthread_self(), sizeof(m_previous),
+                                   &m_previous);
+    }
+    scoped_pin(const scoped_pin&) = delete;
+    scoped_pin& operator=(const scoped_pin&) = delete;
+};
\ No newline at end of file
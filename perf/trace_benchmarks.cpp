@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+#include <hqlockfree/trace.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+static constexpr size_t queue_size = 1024 << 4;
+
+using hqlockfree::cache_size_policy;
+using hqlockfree::no_stats;
+using hqlockfree::queue_tracer;
+
+/* -----------------------------------------------------------------------
+ *  Cost of tracing on the single‑thread roundtrip.
+ *
+ *  * no_stats           – tracing compiled out;
+ *  * queue_tracer, off  – tracing compiled in, no session open;
+ *  * queue_tracer, on   – session open, events streamed to
+ *                         $HQLOCKFREE_TRACE_FILE (default /tmp).  Events the
+ *                         drain cannot keep up with are dropped and
+ *                         reported as `dropped`.
+ * ---------------------------------------------------------------------*/
+
+static std::string trace_path() {
+    const char* env = std::getenv("HQLOCKFREE_TRACE_FILE");
+    return env ? env : "/tmp/hqlockfree_trace_benchmarks.json";
+}
+
+template <template <typename, cache_size_policy, typename> class queue,
+          typename stats_policy>
+static void trace_roundtrip(benchmark::State& st) {
+    const bool session = (st.range(0) != 0);
+    queue<uint64_t, cache_size_policy::pow2, stats_policy> q(0, queue_size);
+
+    if (session)
+        hqlockfree::start_tracing(trace_path());
+
+    uint64_t iteration = 0;
+    for (auto _ : st) {
+        const uint64_t to_send = iteration++;
+        q.push(to_send);
+        uint64_t to_recv = 0;
+        q.pop(to_recv);
+        if (to_recv != to_send) {
+            throw std::runtime_error("oops");
+        }
+    }
+
+    if (session) {
+        hqlockfree::stop_tracing();
+        st.counters["dropped"] = double(hqlockfree::dropped_trace_events());
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+
+BENCHMARK(trace_roundtrip<hqlockfree::spsc_queue, no_stats>)
+    ->ArgName("session")
+    ->Arg(0);
+BENCHMARK(trace_roundtrip<hqlockfree::spsc_queue, queue_tracer<>>)
+    ->ArgName("session")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK(trace_roundtrip<hqlockfree::mpsc_queue, no_stats>)
+    ->ArgName("session")
+    ->Arg(0);
+BENCHMARK(trace_roundtrip<hqlockfree::mpsc_queue, queue_tracer<>>)
+    ->ArgName("session")
+    ->Arg(0)
+    ->Arg(1);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+
+#include "latency_utils.hpp"
+#include "queue_wrappers.hpp"
+#include "traffic_generator.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static constexpr size_t queue_size = 1024 << 6;
+static constexpr uint64_t schedule_per_iteration_ns = 250'000'000;
+static constexpr uint64_t depth_sample_interval_ns = 100'000;
+
+/* Steady 100k msg/s; bursts at 100x for 20ms out of every 250ms. */
+static constexpr double base_rate = 100'000;
+static constexpr double burst_rate = 100 * base_rate;
+static constexpr auto burst = std::chrono::milliseconds(20);
+static constexpr auto period = std::chrono::milliseconds(250);
+
+enum class schedule { poisson, on_off, replay };
+
+static const char* to_string(schedule s) {
+    switch (s) {
+    case schedule::poisson:
+        return "poisson";
+    case schedule::on_off:
+        return "on_off";
+    case schedule::replay:
+        return "replay";
+    }
+    return "unknown";
+}
+
+static const char* to_string(queue_type type) {
+    switch (type) {
+    case queue_type::spsc:
+        return "spsc";
+    case queue_type::mpsc:
+        return "mpsc";
+    case queue_type::fanout:
+        return "fanout";
+    default:
+        return "other";
+    }
+}
+
+/// @brief Replay runs read HQLOCKFREE_REPLAY_FILE (uint64_t ns deltas).
+static traffic_generator make_generator(schedule s) {
+    switch (s) {
+    case schedule::poisson:
+        return traffic_generator::poisson(base_rate);
+    case schedule::on_off:
+        return traffic_generator::on_off(base_rate, burst_rate, burst, period);
+    case schedule::replay:
+        break;
+    }
+    const char* path = std::getenv("HQLOCKFREE_REPLAY_FILE");
+    if (!path)
+        throw std::runtime_error("HQLOCKFREE_REPLAY_FILE not set");
+    return traffic_generator::replay(path);
+}
+
+/* -----------------------------------------------------------------------
+ *  One paced producer, one consumer.  Messages are stamped with their
+ *  scheduled send time (coordinated‑omission corrected), the producer
+ *  samples queue depth after every push.  Set HQLOCKFREE_DEPTH_TRACE to a
+ *  directory to also get a depth‑over‑time CSV per run.
+ * ---------------------------------------------------------------------*/
+
+template <queue_type type>
+static void scheduled_traffic(benchmark::State& st) {
+    const auto which = static_cast<schedule>(st.range(0));
+    st.SetLabel(to_string(which));
+    std::optional<traffic_generator> generator;
+    try {
+        generator.emplace(make_generator(which));
+    } catch (const std::exception& e) {
+        st.SkipWithError(e.what());
+        return;
+    }
+
+    queue_wrapper<stamped_message, type> q(queue_size);
+    latency_histogram<> latency;
+    latency_histogram<> depth;
+    std::vector<std::pair<uint64_t, size_t>> depth_trace;
+    std::atomic<bool> should_run = true;
+    std::atomic_flag started = false;
+
+    std::thread consumer([&]() {
+        started.test_and_set();
+        started.notify_all();
+        uint64_t next = 0;
+
+        while (true) {
+            const bool done = !should_run.load(std::memory_order_acquire);
+            stamped_message msg;
+            if (q.pop(msg)) {
+                latency.record_single_writer(tsc_clock::now() - msg.stamp);
+                if (msg.sequence != (next++)) {
+                    throw std::runtime_error("oops");
+                }
+            } else if (done) {
+                break;
+            }
+        }
+    });
+
+    started.wait(false);
+
+    uint64_t sequence = 0;
+    uint64_t next_depth_sample = 0;
+    for (auto _ : st) {
+        const uint64_t start = tsc_clock::now();
+        const uint64_t start_ns = generator->elapsed_ns();
+        uint64_t scheduled_ns = start_ns;
+        while (scheduled_ns - start_ns < schedule_per_iteration_ns) {
+            scheduled_ns += generator->next_delta_ns();
+            const uint64_t scheduled =
+                start + tsc_clock::from_ns(double(scheduled_ns - start_ns));
+            while (tsc_clock::now() < scheduled) {
+            }
+            q.push(stamped_message{scheduled, sequence++});
+
+            const size_t current_depth = q.size();
+            depth.record_single_writer(current_depth);
+            if (scheduled_ns >= next_depth_sample) {
+                depth_trace.emplace_back(scheduled_ns, current_depth);
+                next_depth_sample = scheduled_ns + depth_sample_interval_ns;
+            }
+        }
+    }
+
+    should_run.store(false, std::memory_order_release);
+    if (consumer.joinable())
+        consumer.join();
+
+    if (const char* dir = std::getenv("HQLOCKFREE_DEPTH_TRACE")) {
+        std::ofstream csv(std::string(dir) + "/" + to_string(type) + "_" +
+                          to_string(which) + ".csv");
+        csv << "schedule_ns,depth\n";
+        for (const auto& [ns, d] : depth_trace)
+            csv << ns << ',' << d << '\n';
+    }
+
+    st.SetItemsProcessed(static_cast<int64_t>(sequence));
+    report_latency(st, latency);
+    st.counters["p99_depth"] = double(depth.percentile(0.99));
+    st.counters["p99.99_depth"] = double(depth.percentile(0.9999));
+    st.counters["max_depth"] = double(depth.max());
+}
+
+static void schedule_args(benchmark::internal::Benchmark* b) {
+    b->ArgName("schedule")
+        ->Arg(static_cast<int64_t>(schedule::poisson))
+        ->Arg(static_cast<int64_t>(schedule::on_off))
+        ->Arg(static_cast<int64_t>(schedule::replay))
+        ->Iterations(4)
+        ->UseRealTime();
+}
+
+BENCHMARK(scheduled_traffic<queue_type::spsc>)->Apply(schedule_args);
+BENCHMARK(scheduled_traffic<queue_type::mpsc>)->Apply(schedule_args);
+BENCHMARK(scheduled_traffic<queue_type::fanout>)->Apply(schedule_args);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* -----------------------------------------------------------------------
+ *  traffic_generator – inter‑arrival schedules for paced benchmarks
+ *
+ *  * poisson – exponentially distributed gaps at a fixed mean rate.
+ *  * on_off  – Poisson at `base_rate`, switching to `burst_rate` for the
+ *              first `burst` of every `period` (market‑open style spikes).
+ *  * replay  – gaps read from a binary file of native‑endian uint64_t
+ *              nanosecond deltas, looped when exhausted.
+ *
+ *  next_delta_ns() returns the gap to the next arrival; callers accumulate
+ *  it into an absolute send schedule.
+ * ---------------------------------------------------------------------*/
+
+class traffic_generator {
+  public:
+    enum class kind { poisson, on_off, replay };
+
+  private:
+    kind m_kind;
+    std::mt19937_64 m_rng;
+    std::exponential_distribution<double> m_base;
+    std::exponential_distribution<double> m_burst;
+    uint64_t m_burst_ns = 0;
+    uint64_t m_period_ns = 0;
+    std::vector<uint64_t> m_deltas;
+    size_t m_next = 0;
+    uint64_t m_elapsed_ns = 0;
+
+    traffic_generator(kind k, double base_rate, double burst_rate,
+                      uint64_t seed)
+        : m_kind(k), m_rng(seed), m_base(base_rate / 1e9),
+          m_burst(burst_rate / 1e9) {}
+
+  public:
+    static traffic_generator poisson(double rate, uint64_t seed = 1) {
+        return traffic_generator(kind::poisson, rate, rate, seed);
+    }
+
+    static traffic_generator on_off(double base_rate, double burst_rate,
+                                    std::chrono::nanoseconds burst,
+                                    std::chrono::nanoseconds period,
+                                    uint64_t seed = 1) {
+        traffic_generator out(kind::on_off, base_rate, burst_rate, seed);
+        out.m_burst_ns = static_cast<uint64_t>(burst.count());
+        out.m_period_ns = static_cast<uint64_t>(period.count());
+        return out;
+    }
+
+    static traffic_generator replay(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("traffic_generator - cannot open " + path);
+        traffic_generator out(kind::replay, 1, 1, 0);
+        uint64_t delta = 0;
+        while (file.read(reinterpret_cast<char*>(&delta), sizeof(delta)))
+            out.m_deltas.push_back(delta);
+        if (out.m_deltas.empty())
+            throw std::runtime_error("traffic_generator - empty " + path);
+        return out;
+    }
+
+    kind type() const { return m_kind; }
+
+    /// @brief Schedule time covered so far.
+    uint64_t elapsed_ns() const { return m_elapsed_ns; }
+
+    /// @brief Is the schedule currently inside a burst (on_off only).
+    bool in_burst() const {
+        return (m_kind == kind::on_off) &&
+               ((m_elapsed_ns % m_period_ns) < m_burst_ns);
+    }
+
+    uint64_t next_delta_ns() {
+        uint64_t delta = 0;
+        switch (m_kind) {
+        case kind::poisson:
+            delta = static_cast<uint64_t>(m_base(m_rng));
+            break;
+        case kind::on_off:
+            delta = static_cast<uint64_t>(in_burst() ? m_burst(m_rng)
+                                                     : m_base(m_rng));
+            break;
+        case kind::replay:
+            delta = m_deltas[m_next];
+            m_next = (m_next + 1) % m_deltas.size();
+            break;
+        }
+        m_elapsed_ns += delta;
+        return delta;
+    }
+};
\ No newline at end of file
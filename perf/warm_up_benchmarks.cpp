@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <hqlockfree/mpmc_fanout.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/* A 64 MB ring, so every first touch of a page in it is a real fault.  The
+ * construction and warm-up outside the timed region dwarf the first messages,
+ * hence a fixed iteration count. */
+static constexpr size_t ring_slots = size_t(1) << 20;
+
+struct message {
+    std::array<uint64_t, 8> fields{};
+};
+
+enum class container { spsc, mpsc, fanout };
+
+/* -----------------------------------------------------------------------
+ *  Time the first range(0) push / pop pairs after construction, with or
+ *  without warm_up() in between (not timed)
+ * ---------------------------------------------------------------------*/
+
+template <container which, bool warm>
+static void first_messages(benchmark::State& st) {
+    const auto messages = static_cast<size_t>(st.range(0));
+    message in{}, out{};
+    for (auto _ : st) {
+        if constexpr (which == container::fanout) {
+            auto q = std::make_unique<hqlockfree::mpmc_fanout<message>>(
+                0, ring_slots);
+            if constexpr (warm)
+                q->warm_up();
+            auto sub = q->subscribe();
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < messages; i++) {
+                in.fields[0] = i;
+                q->push(in);
+                sub->pop(out);
+            }
+            st.SetIterationTime(std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count());
+        } else {
+            using queue_type =
+                std::conditional_t<which == container::spsc,
+                                   hqlockfree::spsc_queue<message>,
+                                   hqlockfree::mpsc_queue<message>>;
+            auto q = std::make_unique<queue_type>(0, ring_slots);
+            if constexpr (warm)
+                q->warm_up();
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < messages; i++) {
+                in.fields[0] = i;
+                q->push(in);
+                q->pop(out);
+            }
+            st.SetIterationTime(std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count());
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    st.SetItemsProcessed(st.iterations() * int64_t(messages));
+}
+
+static void message_counts(benchmark::internal::Benchmark* b) {
+    b->ArgName("messages")
+        ->Arg(64)
+        ->Arg(1024)
+        ->Arg(16384)
+        ->UseManualTime()
+        ->Iterations(20)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+#define WARM_UP_PAIR(which)                                                    \
+    BENCHMARK(first_messages<which, false>)->Apply(message_counts);            \
+    BENCHMARK(first_messages<which, true>)->Apply(message_counts)
+
+WARM_UP_PAIR(container::spsc);
+WARM_UP_PAIR(container::mpsc);
+WARM_UP_PAIR(container::fanout);
+
+BENCHMARK_MAIN();
\ No newline at end of file
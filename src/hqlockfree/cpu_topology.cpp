@@ -0,0 +1,106 @@
+#include <hqlockfree/cpu_topology.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <fstream>
+#include <optional>
+#include <sstream>
+
+namespace hqlockfree {
+
+namespace {
+
+std::optional<std::string> read_sysfs(const std::string& path) {
+    std::ifstream file(path);
+    std::string value;
+    if (!file || !std::getline(file, value))
+        return std::nullopt;
+    return value;
+}
+
+} // namespace
+
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> out;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n")
+            continue;
+        const auto dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = (dash == std::string::npos)
+                             ? first
+                             : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; cpu++)
+            out.push_back(cpu);
+    }
+    return out;
+}
+
+std::vector<int> read_cpu_list(const std::string& path) {
+    const auto value = read_sysfs(path);
+    return value ? parse_cpu_list(*value) : std::vector<int>{};
+}
+
+std::vector<cpu_info> read_cpu_topology() {
+    static const std::string root = "/sys/devices/system/cpu/";
+    std::vector<cpu_info> out;
+    for (int cpu : read_cpu_list(root + "online")) {
+        const std::string base = root + "cpu" + std::to_string(cpu) + "/";
+        const auto core = read_sysfs(base + "topology/core_id");
+        const auto package =
+            read_sysfs(base + "topology/physical_package_id");
+        if (!core || !package)
+            continue;
+        cpu_info info{cpu, std::stoi(*core), std::stoi(*package), -1};
+        for (int index = 0;; index++) {
+            const std::string cache =
+                base + "cache/index" + std::to_string(index) + "/";
+            const auto level = read_sysfs(cache + "level");
+            if (!level)
+                break;
+            const auto shared = read_sysfs(cache + "shared_cpu_list");
+            if (shared && std::stoi(*level) >= 2) {
+                const auto cpus = parse_cpu_list(*shared);
+                if (!cpus.empty())
+                    info.llc = cpus.front();
+            }
+        }
+        if (info.llc < 0)
+            info.llc = info.package;
+        out.push_back(info);
+    }
+    return out;
+}
+
+std::vector<int> allowed_cpus() {
+    std::vector<int> out;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        return out;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        if (CPU_ISSET(cpu, &set))
+            out.push_back(cpu);
+    return out;
+}
+
+bool pin_current_thread(int cpu) {
+    if (cpu < 0)
+        return true;
+    return pin_current_thread(std::vector<int>{cpu});
+}
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+    if (cpus.empty())
+        return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus)
+        CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+} // namespace hqlockfree
\ No newline at end of file
@@ -1,46 +1,399 @@
 #include <hqlockfree/daemon.hpp>
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
 
 namespace hqlockfree {
 
-void daemon::run_callbacks() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto& [key, callback] : m_callbacks) {
-        callback();
+namespace {
+
+/// @brief The entry of @p snapshot with @p key, or nullptr if removed.
+template <typename registry>
+auto find_entry(const registry& snapshot, callback_key_t key) {
+    auto found = std::lower_bound(
+        snapshot.begin(), snapshot.end(), key,
+        [](const auto& entry, callback_key_t k) { return entry.key < k; });
+    return (found != snapshot.end() && found->key == key) ? &*found
+                                                          : nullptr;
+}
+
+} // namespace
+
+uint64_t daemon::ticks(clock::time_point t) const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - m_epoch)
+        .count();
+}
+
+uint64_t daemon::ticks(std::chrono::nanoseconds d) {
+    /* rounded up, and at least one tick so a period always advances */
+    const auto us = std::chrono::ceil<std::chrono::microseconds>(d).count();
+    return static_cast<uint64_t>(std::max<int64_t>(us, 1));
+}
+
+daemon::clock::time_point daemon::time_of(uint64_t tick) const {
+    return m_epoch + std::chrono::microseconds(tick);
+}
+
+const daemon::registry* daemon::enter(shard& s) {
+    /* announce the snapshot before walking it, and re‑check that it is still
+     * current: a writer that swapped it out in between either sees the
+     * announcement or is seen here */
+    const registry* snapshot;
+    do {
+        snapshot = s.current.load(std::memory_order_seq_cst);
+        s.walking.store(snapshot, std::memory_order_seq_cst);
+    } while (snapshot != s.current.load(std::memory_order_seq_cst));
+    return snapshot;
+}
+
+void daemon::leave(shard& s) {
+    s.walking.store(nullptr, std::memory_order_release);
+    s.walking.notify_all(); // a writer may be waiting to free the snapshot
+}
+
+void daemon::synchronise(worker_state& state, const registry* snapshot,
+                         uint64_t now) {
+    /* idempotent, so a generation read before a concurrent publish costs
+     * only a repeat on the next pass */
+    state.every_pass = false;
+    state.tight = false;
+    for (const auto& entry : *snapshot) {
+        const bool timed = entry.once || entry.period.count() != 0;
+        state.every_pass |= !timed;
+        state.tight |= entry.deadline.count() != 0 &&
+                       entry.deadline < m_spin_margin;
+        /* keys only grow, so everything from `scheduled` on is new */
+        if (timed && entry.key >= state.scheduled)
+            state.wheel.schedule(now + ticks(entry.period), entry.key);
+    }
+    if (!snapshot->empty())
+        state.scheduled = std::max(state.scheduled, snapshot->back().key + 1);
+}
+
+void daemon::run_callbacks(shard& s, worker_state& state) {
+    /* read before the snapshot: publish bumps it after the swap.  Compared
+     * instead of the snapshot address, which a new snapshot may reuse */
+    const uint64_t generation = s.generation.load(std::memory_order_seq_cst);
+    const registry* snapshot = enter(s);
+    uint64_t now = ticks(clock::now());
+    if (generation != state.generation) {
+        synchronise(state, snapshot, now);
+        state.generation = generation;
+    }
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    state.tsc = tsc_clock::now();
+#endif
+
+    if (state.every_pass) {
+        for (const auto& entry : *snapshot) {
+            if (!entry.once && entry.period.count() == 0)
+                invoke(state, entry);
+        }
+        now = ticks(clock::now());
+    }
+
+    state.wheel.advance(now, [&](uint64_t due, callback_key_t key) {
+        const callback_entry* entry = find_entry(*snapshot, key);
+        if (entry == nullptr)
+            return; // removed since it was scheduled
+        /* late by the callbacks expired before it, too */
+        if (entry->deadline.count() != 0 &&
+            ticks(clock::now()) - due > ticks(entry->deadline))
+            m_missed_deadlines.fetch_add(1, std::memory_order_relaxed);
+        invoke(state, *entry);
+        if (entry->once) {
+            state.finished.push_back(key);
+            return;
+        }
+        /* keep the cadence; after an overrun, skip the missed runs */
+        const uint64_t period = ticks(entry->period);
+        state.wheel.schedule((due + period > now) ? due + period : now + period,
+                             key);
+    });
+    leave(s);
+
+    for (const auto key : state.finished)
+        remove_callback(key);
+    state.finished.clear();
+}
+
+void daemon::invoke(worker_state& state, const callback_entry& entry) {
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    /* one tsc read per run: runs in a pass follow each other closely, so
+     * the previous run's end stands in for this one's start */
+    callback_timing& timing = *entry.timing;
+    const uint64_t start = state.tsc;
+    entry.func();
+    state.tsc = tsc_clock::now();
+    const uint64_t runtime = state.tsc - start;
+    timing.runtime.record_single_writer(runtime);
+    if (timing.last_start != 0)
+        timing.interval.record_single_writer(start - timing.last_start);
+    timing.last_start = start;
+
+    const uint64_t threshold = m_overrun_ticks.load(std::memory_order_relaxed);
+    if (threshold != 0 && runtime > threshold) {
+        timing.overruns.fetch_add(1, std::memory_order_relaxed);
+        std::function<void(callback_key_t, std::chrono::nanoseconds)> hook;
+        {
+            std::lock_guard<std::mutex> lock(m_hook_mutex);
+            hook = m_hook;
+        }
+        if (hook)
+            hook(entry.key, std::chrono::nanoseconds(static_cast<int64_t>(
+                                tsc_clock::to_ns(runtime))));
+        state.tsc = tsc_clock::now(); // the hook is not the next run's time
+    }
+#else
+    (void)state;
+    entry.func();
+#endif
+}
+
+void daemon::wait_for_next(shard& s, const worker_state& state) {
+    if (state.every_pass || m_policy == wait_policy::spin)
+        return;
+    const auto due = state.wheel.next_due();
+    const bool spin_before_due = (m_policy == wait_policy::hybrid) ||
+                                 state.tight;
+    std::unique_lock<std::mutex> lock(s.sleep_mutex);
+    auto woken = [&]() {
+        return !m_should_run.load(std::memory_order_relaxed) ||
+               s.generation.load(std::memory_order_acquire) !=
+                   state.generation;
+    };
+    if (!due) {
+        s.wake.wait(lock, woken);
+        return;
     }
+    auto until = time_of(*due);
+    if (spin_before_due)
+        until -= m_spin_margin; // if already past, the loop spins
+    s.wake.wait_until(lock, until, woken);
 }
 
-void daemon::run() {
+void daemon::run(shard& s) {
+    worker_state state{timer_wheel<callback_key_t>(ticks(clock::now()))};
     while (m_should_run.load(std::memory_order_seq_cst)) {
-        run_callbacks();
+        run_callbacks(s, state);
+        wait_for_next(s, state);
     }
 }
 
-daemon::daemon() {
-    m_should_run = true;
-    m_thread = std::thread([&]() { this->run(); });
+daemon::daemon(wait_policy policy, std::chrono::nanoseconds spin_margin)
+    : daemon(1, {}, policy, spin_margin) {}
+
+daemon::daemon(size_t workers, std::vector<int> cpus, wait_policy policy,
+               std::chrono::nanoseconds spin_margin)
+    : m_policy(policy), m_spin_margin(spin_margin) {
+    if (workers == 0)
+        throw std::invalid_argument("hqlockfree::daemon: no workers");
+    /* all shards exist before any worker runs: keys index into m_shards */
+    for (size_t i = 0; i < workers; i++)
+        m_shards.push_back(
+            std::make_unique<shard>(i < cpus.size() ? cpus[i] : -1));
+    try {
+        for (auto& s : m_shards) {
+            s->thread =
+                std::thread([this, &worker = *s]() { this->run(worker); });
+            if (s->cpu < 0)
+                continue;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(s->cpu, &set);
+            if (const int err = pthread_setaffinity_np(
+                    s->thread.native_handle(), sizeof(set), &set))
+                throw std::system_error(err, std::generic_category(),
+                                        "hqlockfree::daemon: cannot pin to "
+                                        "cpu " + std::to_string(s->cpu));
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
 }
 
-daemon::~daemon() {
+void daemon::stop() {
     m_should_run.store(false, std::memory_order_seq_cst);
-    if (m_thread.joinable())
-        m_thread.join();
+    for (auto& s : m_shards) {
+        {
+            std::lock_guard<std::mutex> lock(s->sleep_mutex);
+        }
+        s->wake.notify_all();
+    }
+    for (auto& s : m_shards) {
+        if (s->thread.joinable())
+            s->thread.join();
+    }
+}
+
+daemon::~daemon() { stop(); }
+
+bool daemon::on_worker() const {
+    const auto self = std::this_thread::get_id();
+    return std::any_of(m_shards.begin(), m_shards.end(), [self](auto& s) {
+        return s->thread.get_id() == self;
+    });
+}
+
+void daemon::publish(shard& s, std::unique_lock<std::mutex>& lock,
+                     const registry* next, bool wait_for_worker) {
+    s.retired.emplace_back(s.current.exchange(next, std::memory_order_seq_cst));
+    s.generation.fetch_add(1, std::memory_order_seq_cst);
+    {
+        /* a sleeping worker re‑checks the generation under this lock */
+        std::lock_guard<std::mutex> sleep_lock(s.sleep_mutex);
+    }
+    s.wake.notify_one();
+    reclaim(s, lock, wait_for_worker);
+}
+
+void daemon::reclaim(shard& s, std::unique_lock<std::mutex>& lock,
+                     bool wait_for_worker) {
+    /* a callback editing a registry runs on a worker, mid‑pass: it cannot
+     * wait for its own snapshot, which stays retired until a later publish,
+     * nor for another worker, which may be waiting for it in turn */
+    if (on_worker())
+        wait_for_worker = false;
+    while (true) {
+        const registry* walking = s.walking.load(std::memory_order_seq_cst);
+        std::erase_if(s.retired, [walking](const auto& old) {
+            return old.get() != walking;
+        });
+        if (s.retired.empty() || !wait_for_worker)
+            return;
+        /* not under the lock: the callbacks of the pass being waited for
+         * may themselves add or remove callbacks on this shard */
+        lock.unlock();
+        s.walking.wait(walking, std::memory_order_seq_cst);
+        lock.lock();
+    }
+}
+
+size_t daemon::shard_of(const void* owner) const {
+    /* objects are aligned, so fold the high bits into the low ones */
+    auto bits = reinterpret_cast<uintptr_t>(owner);
+    bits ^= bits >> 17;
+    bits *= 0x9e3779b97f4a7c15ULL;
+    bits ^= bits >> 29;
+    return bits % m_shards.size();
 }
 
-callback_key_t daemon::add_callback(std::function<void()> func) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    callback_key_t key = m_next_callback++;
-    m_callbacks[key] = func;
+callback_key_t daemon::add(size_t index, callback_entry entry) {
+    if (index >= m_shards.size())
+        throw std::out_of_range("hqlockfree::daemon: no shard " +
+                                std::to_string(index));
+    shard& s = *m_shards[index];
+    std::unique_lock<std::mutex> lock(s.mutex);
+    /* increasing within the shard, so its registry stays sorted */
+    const callback_key_t key = entry.key =
+        s.next_sequence++ * m_shards.size() + index;
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    entry.timing = std::make_shared<callback_timing>();
+#endif
+    auto next = std::make_unique<registry>(
+        *s.current.load(std::memory_order_relaxed));
+    next->push_back(std::move(entry));
+    publish(s, lock, next.release(), false); // nothing to wait for: it is new
     return key;
 }
 
+callback_key_t daemon::add_callback(std::function<void()> func,
+                                    std::chrono::nanoseconds period,
+                                    std::chrono::nanoseconds deadline) {
+    return add_callback_to(next_shard(), std::move(func), period, deadline);
+}
+
+callback_key_t daemon::add_callback_to(size_t shard,
+                                       std::function<void()> func,
+                                       std::chrono::nanoseconds period,
+                                       std::chrono::nanoseconds deadline) {
+    return add(shard, {0, std::move(func), period, deadline, false});
+}
+
+callback_key_t daemon::schedule_every(std::chrono::nanoseconds period,
+                                      std::function<void()> func,
+                                      std::chrono::nanoseconds deadline) {
+    if (period <= std::chrono::nanoseconds::zero())
+        throw std::invalid_argument("hqlockfree::daemon: period must be > 0");
+    return add_callback(std::move(func), period, deadline);
+}
+
+callback_key_t daemon::schedule_after(std::chrono::nanoseconds delay,
+                                      std::function<void()> func) {
+    return add(next_shard(), {0, std::move(func), delay, {}, true});
+}
+
 void daemon::remove_callback(callback_key_t key) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_callbacks.find(key) == m_callbacks.end())
+    shard& s = *m_shards[key % m_shards.size()];
+    std::unique_lock<std::mutex> lock(s.mutex);
+    const registry& current = *s.current.load(std::memory_order_relaxed);
+    auto found = std::find_if(current.begin(), current.end(),
+                              [key](const auto& entry) {
+                                  return entry.key == key;
+                              });
+    if (found == current.end()) {
+        /* already gone, but a concurrent remove may still be waiting for
+         * the worker to leave a snapshot that has it */
+        reclaim(s, lock, true);
         return;
-    m_callbacks.erase(key);
+    }
+    auto next = std::make_unique<registry>();
+    next->reserve(current.size() - 1);
+    for (const auto& entry : current) {
+        if (entry.key != key)
+            next->push_back(entry);
+    }
+    publish(s, lock, next.release(), true);
+}
+
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+std::vector<callback_profile> daemon::profile() const {
+    auto ns = [](uint64_t ticks) {
+        return std::chrono::nanoseconds(
+            static_cast<int64_t>(tsc_clock::to_ns(ticks)));
+    };
+    std::vector<callback_profile> out;
+    for (const auto& s : m_shards) {
+        /* the writers' lock keeps the snapshot alive while it is read */
+        std::lock_guard<std::mutex> lock(s->mutex);
+        for (const auto& entry : *s->current.load(std::memory_order_relaxed)) {
+            const callback_timing& t = *entry.timing;
+            out.push_back({entry.key, t.runtime.count(),
+                           t.overruns.load(std::memory_order_relaxed),
+                           ns(t.runtime.percentile(0.5)),
+                           ns(t.runtime.percentile(0.99)),
+                           ns(t.runtime.max()), ns(t.interval.percentile(0.5)),
+                           ns(t.interval.percentile(0.99)),
+                           ns(t.interval.max())});
+        }
+    }
+    std::sort(out.begin(), out.end(),
+              [](const auto& a, const auto& b) { return a.key < b.key; });
+    return out;
+}
+
+void daemon::set_overrun_hook(
+    std::chrono::nanoseconds threshold,
+    std::function<void(callback_key_t, std::chrono::nanoseconds)> hook) {
+    std::lock_guard<std::mutex> lock(m_hook_mutex);
+    const bool on = static_cast<bool>(hook);
+    m_hook = std::move(hook);
+    /* at least one tick, so that 0 keeps meaning "off" */
+    m_overrun_ticks.store(
+        on ? std::max<uint64_t>(tsc_clock::from_ns(double(threshold.count())),
+                                1)
+           : 0,
+        std::memory_order_relaxed);
 }
+#endif
 
 daemon* find_or_create_daemon() {
     static std::unique_ptr<daemon> g_daemon;
@@ -0,0 +1,125 @@
+#include <hqlockfree/cache_utils.hpp>
+#include <hqlockfree/cpu_topology.hpp>
+#include <hqlockfree/interference.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hqlockfree {
+
+namespace {
+
+constexpr size_t separations[] = {64, 128, 256, 4096};
+constexpr size_t separation_count = std::size(separations);
+constexpr uint64_t iterations = uint64_t(1) << 20;
+constexpr int repeats = 3;
+/* slowdown, relative to a page apart, still counted as "no sharing" */
+constexpr double tolerance = 1.25;
+
+size_t read_coherency_line_size() {
+    std::ifstream file(
+        "/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size");
+    size_t value = 0;
+    if (!(file >> value))
+        return 0;
+    return value;
+}
+
+/// @brief Two CPUs this thread may use on different physical cores – SMT
+/// siblings share L1, so every separation would time the same.
+std::optional<std::pair<int, int>> distinct_cores() {
+    const auto allowed = allowed_cpus();
+    auto usable = [&](const cpu_info& c) {
+        return std::find(allowed.begin(), allowed.end(), c.cpu) !=
+               allowed.end();
+    };
+    const auto cpus = read_cpu_topology();
+    for (const auto& a : cpus) {
+        for (const auto& b : cpus) {
+            if (usable(a) && usable(b) &&
+                (a.package != b.package || a.core != b.core))
+                return std::pair{a.cpu, b.cpu};
+        }
+    }
+    return std::nullopt;
+}
+
+/// @brief ns per increment when two threads on @p cpu_a / @p cpu_b bump
+/// counters @p separation bytes apart (best of `repeats`).
+double time_separation(size_t separation, int cpu_a, int cpu_b) {
+    constexpr size_t page = 4096;
+    void* raw = std::aligned_alloc(page, 2 * page);
+    if (raw == nullptr)
+        throw std::bad_alloc();
+    auto* bytes = static_cast<char*>(raw);
+    auto* first = new (bytes) std::atomic<uint64_t>(0);
+    auto* second = new (bytes + separation) std::atomic<uint64_t>(0);
+
+    double best = 0;
+    for (int r = 0; r < repeats; r++) {
+        std::atomic<int> ready{0};
+        double elapsed[2] = {};
+        auto hammer = [&](int cpu, std::atomic<uint64_t>* counter,
+                          double& out) {
+            pin_current_thread(cpu);
+            ready.fetch_add(1, std::memory_order_acq_rel);
+            while (ready.load(std::memory_order_acquire) < 2) {
+            }
+            const auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < iterations; i++)
+                counter->fetch_add(1, std::memory_order_relaxed);
+            out = std::chrono::duration<double, std::nano>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+        };
+        std::thread a(hammer, cpu_a, first, std::ref(elapsed[0]));
+        std::thread b(hammer, cpu_b, second, std::ref(elapsed[1]));
+        a.join();
+        b.join();
+        const double ns =
+            std::max(elapsed[0], elapsed[1]) / double(iterations);
+        best = (r == 0) ? ns : std::min(best, ns);
+    }
+    std::free(raw);
+    return best;
+}
+
+} // namespace
+
+interference_report probe_interference() {
+    interference_report report;
+    report.coherency_line_size = read_coherency_line_size();
+
+    if (const auto cpus = distinct_cores()) {
+        for (size_t i = 0; i < separation_count; i++)
+            report.ns_per_op[i] = time_separation(separations[i],
+                                                  cpus->first, cpus->second);
+        const double apart = report.ns_per_op[separation_count - 1];
+        report.measured = separations[separation_count - 2];
+        for (size_t i = 0; i + 1 < separation_count; i++) {
+            if (report.ns_per_op[i] <= apart * tolerance) {
+                report.measured = separations[i];
+                break;
+            }
+        }
+    }
+
+    report.recommended =
+        std::max(report.coherency_line_size, report.measured);
+    if (report.recommended == 0)
+        report.recommended = destructive_interference_size;
+    return report;
+}
+
+} // namespace hqlockfree
\ No newline at end of file
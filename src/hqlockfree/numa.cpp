@@ -0,0 +1,113 @@
+#include <hqlockfree/cpu_topology.hpp>
+#include <hqlockfree/numa.hpp>
+
+#include <sys/syscall.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hqlockfree {
+
+namespace {
+
+/* from <linux/mempolicy.h>, which is not always installed */
+constexpr int mpol_bind = 2;
+constexpr int mpol_interleave = 3;
+constexpr unsigned mpol_mf_move = 1U << 1;
+constexpr int mpol_f_node = 1;
+constexpr int mpol_f_addr = 2;
+
+std::vector<int> cpus_of_node(int node) {
+    return read_cpu_list("/sys/devices/system/node/node" +
+                         std::to_string(node) + "/cpulist");
+}
+
+/// @brief Touch every page p of the range with p % nodes.size() == slot from
+/// a thread pinned to @p node.
+void touch_from_node(char* bytes, size_t length, size_t page, int node,
+                     size_t slot, size_t slots) {
+    std::thread toucher([=]() {
+        pin_current_thread(cpus_of_node(node));
+        auto* volatile_bytes = static_cast<volatile char*>(bytes);
+        for (size_t offset = slot * page; offset < length;
+             offset += slots * page)
+            volatile_bytes[offset] = volatile_bytes[offset];
+    });
+    toucher.join();
+}
+
+} // namespace
+
+int numa_node_count() {
+    const auto nodes = read_cpu_list("/sys/devices/system/node/online");
+    return nodes.empty() ? 1 : static_cast<int>(nodes.size());
+}
+
+uint64_t numa_online_nodes() {
+    uint64_t mask = 0;
+    for (int node : read_cpu_list("/sys/devices/system/node/online"))
+        if (node < 64)
+            mask |= uint64_t(1) << node;
+    return mask ? mask : 1;
+}
+
+int numa_node_of_cpu(int cpu) {
+    for (int node : read_cpu_list("/sys/devices/system/node/online")) {
+        for (int c : cpus_of_node(node))
+            if (c == cpu)
+                return node;
+    }
+    return 0;
+}
+
+int current_numa_node() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+        return 0;
+    return static_cast<int>(node);
+}
+
+int numa_node_of(const void* address) {
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address,
+                mpol_f_node | mpol_f_addr) != 0)
+        return -1;
+    return node;
+}
+
+bool apply_numa_placement(void* address, size_t length,
+                          const numa_placement& where) {
+    if (where.policy == numa_placement::kind::none || where.nodes == 0)
+        return false;
+    const int mode = (where.policy == numa_placement::kind::bind)
+                         ? mpol_bind
+                         : mpol_interleave;
+    const uint64_t mask = where.nodes;
+    /* maxnode is one past the last bit the kernel reads */
+    const unsigned long maxnode = sizeof(mask) * 8 + 1;
+    if (syscall(SYS_mbind, address, length, mode, &mask, maxnode,
+                mpol_mf_move) == 0)
+        return true;
+    first_touch(address, length, where);
+    return false;
+}
+
+void first_touch(void* address, size_t length, const numa_placement& where) {
+    if (where.policy == numa_placement::kind::none || where.nodes == 0)
+        return;
+    std::vector<int> nodes;
+    for (int node = 0; node < 64; node++)
+        if (where.nodes & (uint64_t(1) << node))
+            nodes.push_back(node);
+    if (where.policy == numa_placement::kind::bind)
+        nodes.resize(1);
+
+    const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t slot = 0; slot < nodes.size(); slot++)
+        touch_from_node(static_cast<char*>(address), length, page, nodes[slot],
+                        slot, nodes.size());
+}
+
+} // namespace hqlockfree
\ No newline at end of file
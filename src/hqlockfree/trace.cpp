@@ -0,0 +1,163 @@
+#include <hqlockfree/spsc_queue.hpp>
+#include <hqlockfree/trace.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace hqlockfree {
+
+namespace {
+
+/// @brief Events buffered per thread before the drain catches up.
+constexpr size_t trace_buffer_events = 1 << 14;
+/// @brief How often the daemon drains; file I/O must not run on every pass
+/// of a loop the fan‑outs' min‑tail scans share.
+constexpr auto drain_period = std::chrono::milliseconds(1);
+
+struct thread_buffer {
+    spsc_queue<trace_event> events{0, trace_buffer_events};
+    const uint64_t tid;
+    explicit thread_buffer(uint64_t id) : tid(id) {}
+};
+
+struct trace_state {
+    std::mutex mutex; ///< Protects everything below
+    std::vector<std::shared_ptr<thread_buffer>> buffers;
+    uint64_t next_tid = 1;
+
+    std::ofstream file;
+    bool first_event = true;
+    uint64_t start_ticks = 0;
+    daemon* drainer = nullptr;
+    callback_key_t callback_key = 0;
+    std::atomic<uint64_t> dropped{0};
+};
+
+trace_state& state() {
+    static trace_state g_state;
+    return g_state;
+}
+
+const char* name_of(trace_kind kind) {
+    switch (kind) {
+    case trace_kind::push:
+        return "push";
+    case trace_kind::pop:
+        return "pop";
+    case trace_kind::full_wait:
+        return "full_wait";
+    case trace_kind::daemon_scan:
+        return "daemon_scan";
+    }
+    return "unknown";
+}
+
+double to_us(uint64_t ticks) { return tsc_clock::to_ns(ticks) / 1000.0; }
+
+void write_event(trace_state& s, uint64_t tid, const trace_event& event) {
+    const uint64_t begin =
+        (event.begin > s.start_ticks) ? (event.begin - s.start_ticks) : 0;
+    s.file << (s.first_event ? "\n" : ",\n") << R"({"name":")"
+           << name_of(event.kind) << R"(","cat":"hqlockfree","pid":)"
+           << getpid() << R"(,"tid":)" << tid << R"(,"ts":)" << to_us(begin);
+    if (event.duration == 0)
+        s.file << R"(,"ph":"i","s":"t")";
+    else
+        s.file << R"(,"ph":"X","dur":)" << to_us(event.duration);
+    s.file << R"(,"args":{"queue":")" << event.queue << R"(","index":)"
+           << event.index << "}}";
+    s.first_event = false;
+}
+
+/// @brief Empty every thread's buffer into the file (or discard if closed)
+/// and forget buffers whose thread has exited.  Caller holds `s.mutex`.
+void drain(trace_state& s) {
+    trace_event event;
+    for (auto it = s.buffers.begin(); it != s.buffers.end();) {
+        auto& buffer = *it;
+        while (buffer->events.pop(event)) {
+            if (s.file.is_open())
+                write_event(s, buffer->tid, event);
+        }
+        if (buffer.use_count() == 1)
+            it = s.buffers.erase(it);
+        else
+            ++it;
+    }
+}
+
+} // namespace
+
+void start_tracing(const std::string& path, daemon* drainer) {
+    auto& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.file.is_open())
+            throw std::runtime_error("start_tracing - session already open");
+        drain(s); // discard events that raced the previous stop
+        s.file.open(path, std::ios::trunc);
+        if (!s.file)
+            throw std::runtime_error("start_tracing - cannot open " + path);
+        s.file << std::fixed << std::setprecision(3) << R"({"traceEvents":[)";
+        s.first_event = true;
+        s.start_ticks = tsc_clock::now();
+        s.dropped.store(0, std::memory_order_relaxed);
+        s.drainer = drainer ? drainer : find_or_create_daemon();
+        /* registered after the daemon singleton exists, so this runs
+         * before it and the state are destroyed */
+        static std::once_flag at_exit;
+        std::call_once(at_exit, []() { std::atexit(stop_tracing); });
+        /* add_callback never waits for the worker, so holding our lock is
+         * fine; the key is set before stop_tracing() can see the session */
+        s.callback_key = s.drainer->schedule_every(drain_period, [&s]() {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            drain(s);
+        });
+        g_tracing.store(true, std::memory_order_release);
+    }
+}
+
+void stop_tracing() {
+    auto& s = state();
+    if (!g_tracing.exchange(false, std::memory_order_acq_rel))
+        return;
+    /* outside our lock: a running drain takes it, and remove_callback
+     * waits for that drain to finish */
+    s.drainer->remove_callback(s.callback_key);
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    drain(s);
+    s.file << "\n],\"displayTimeUnit\":\"ns\"}";
+    s.file.close();
+}
+
+void record_trace_event(const trace_event& event) {
+    static thread_local std::shared_ptr<thread_buffer> t_buffer;
+    auto& s = state();
+    if (!t_buffer) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        t_buffer = s.buffers.emplace_back(
+            std::make_shared<thread_buffer>(s.next_tid++));
+    }
+    /* single producer: only the drain can shrink the ring under us */
+    auto& events = t_buffer->events;
+    if (events.size() + 1 >= events.capacity()) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    events.push(event);
+}
+
+uint64_t dropped_trace_events() {
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace hqlockfree
\ No newline at end of file
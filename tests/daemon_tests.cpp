@@ -0,0 +1,262 @@
+#include <hqlockfree/daemon.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace hqlockfree;
+using namespace std::chrono_literals;
+
+TEST(Daemon, RemoveWaitsForARunningCallback) {
+    hqlockfree::daemon d;
+    std::atomic<bool> running{false};
+    std::atomic<int> calls{0};
+    const auto key = d.add_callback([&]() {
+        running = true;
+        std::this_thread::sleep_for(20ms);
+        calls++;
+        running = false;
+    });
+    while (!running)
+        std::this_thread::yield();
+    d.remove_callback(key);
+    EXPECT_FALSE(running);
+    const int after = calls;
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(calls, after);
+}
+
+TEST(Daemon, AddDoesNotWaitForTheScan) {
+    hqlockfree::daemon d;
+    std::atomic<bool> running{false};
+    const auto slow = d.add_callback([&]() {
+        running = true;
+        std::this_thread::sleep_for(500ms);
+    });
+    while (!running)
+        std::this_thread::yield();
+
+    std::atomic<int> calls{0};
+    const auto start = std::chrono::steady_clock::now();
+    const auto fast = d.add_callback([&]() { calls++; });
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 250ms);
+
+    d.remove_callback(slow);
+    while (calls == 0)
+        std::this_thread::yield();
+    d.remove_callback(fast);
+}
+
+TEST(Daemon, CallbackMayRemoveItself) {
+    hqlockfree::daemon d;
+    std::atomic<bool> removed{false};
+    callback_key_t key = 0;
+    std::atomic<bool> registered{false};
+    key = d.add_callback([&]() {
+        if (registered && !removed) {
+            d.remove_callback(key);
+            removed = true;
+        }
+    });
+    registered = true;
+    while (!removed)
+        std::this_thread::yield();
+}
+
+/// @brief Add and remove from a callback while this thread removes from the
+/// same shard; exit 0 when done, 1 if that deadlocks.
+[[noreturn]] static void edit_from_callback_and_outside() {
+    std::thread([]() {
+        std::this_thread::sleep_for(10s);
+        _exit(1);
+    }).detach();
+    hqlockfree::daemon d;
+    std::atomic<int> edits{0};
+    const auto editor = d.add_callback([&]() {
+        d.remove_callback(d.schedule_after(1h, []() {}));
+        edits++;
+    });
+    for (int i = 0; i < 500 || edits < 100; i++)
+        d.remove_callback(d.add_callback([]() {}));
+    d.remove_callback(editor);
+    std::_Exit(0);
+}
+
+TEST(Daemon, CallbackMayEditItsShardWhileARemoveWaits) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe"); // fresh worker threads
+    EXPECT_EXIT(edit_from_callback_and_outside(),
+                ::testing::ExitedWithCode(0), "");
+}
+
+TEST(Daemon, ScheduleEveryKeepsItsPeriodWhileSleeping) {
+    hqlockfree::daemon d(wait_policy::sleep);
+    std::atomic<int> calls{0};
+    EXPECT_THROW(d.schedule_every(0ms, [&]() { calls++; }),
+                 std::invalid_argument);
+    EXPECT_THROW(d.schedule_every(-1ms, [&]() { calls++; }),
+                 std::invalid_argument);
+    const auto start = std::chrono::steady_clock::now();
+    const auto key = d.schedule_every(10ms, [&]() { calls++; });
+    std::this_thread::sleep_for(205ms);
+    d.remove_callback(key);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    /* ~20 runs; loose bounds for a loaded machine */
+    EXPECT_GE(calls, 10);
+    EXPECT_LE(calls, elapsed / 10ms + 1);
+}
+
+TEST(Daemon, ScheduleAfterRunsOnceAndNotEarly) {
+    hqlockfree::daemon d(wait_policy::hybrid);
+    std::atomic<int> calls{0};
+    std::atomic<std::chrono::steady_clock::time_point> ran{};
+    const auto start = std::chrono::steady_clock::now();
+    d.schedule_after(30ms, [&]() {
+        ran = std::chrono::steady_clock::now();
+        calls++;
+    });
+    while (calls == 0)
+        std::this_thread::yield();
+    EXPECT_GE(ran.load() - start, 30ms);
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(calls, 1);
+
+    /* cancelled before it is due: never runs */
+    const auto key = d.schedule_after(20ms, [&]() { calls++; });
+    d.remove_callback(key);
+    std::this_thread::sleep_for(40ms);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(Daemon, WorkersShareTheCallbacks) {
+    EXPECT_THROW(hqlockfree::daemon none(0), std::invalid_argument);
+
+    hqlockfree::daemon d(3);
+    ASSERT_EQ(d.workers(), 3u);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::vector<std::atomic<int>> calls(30);
+    std::vector<callback_key_t> keys;
+    for (size_t i = 0; i < calls.size(); i++) {
+        auto run = [&, i]() {
+            if (calls[i]++ == 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            }
+        };
+        /* round‑robin, explicit and hashed placement */
+        keys.push_back(i % 3 == 0   ? d.add_callback(run)
+                       : i % 3 == 1 ? d.add_callback_to(i % d.workers(), run)
+                                    : d.add_callback_to(
+                                          d.shard_of(&calls[i]), run));
+    }
+    for (auto& c : calls) {
+        while (c == 0)
+            std::this_thread::yield();
+    }
+    EXPECT_EQ(threads.size(), 3u);
+
+    for (auto key : keys)
+        d.remove_callback(key);
+    std::vector<int> after(calls.begin(), calls.end());
+    std::this_thread::sleep_for(20ms);
+    for (size_t i = 0; i < calls.size(); i++)
+        EXPECT_EQ(calls[i], after[i]);
+}
+
+TEST(Daemon, PinsWorkersToTheirCpus) {
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed))
+        cpu++;
+
+    hqlockfree::daemon d(2, {-1, cpu});
+    std::atomic<int> seen{-2};
+    const auto key = d.add_callback_to(1, [&]() { seen = sched_getcpu(); });
+    while (seen == -2)
+        std::this_thread::yield();
+    d.remove_callback(key);
+    EXPECT_EQ(seen, cpu);
+
+    EXPECT_THROW(hqlockfree::daemon bad(1, {CPU_SETSIZE - 1}),
+                 std::system_error);
+}
+
+TEST(Daemon, ProfilesRunsAndReportsOverruns) {
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    hqlockfree::daemon d(wait_policy::sleep);
+    std::atomic<int> slow_runs{0};
+    std::atomic<callback_key_t> overrun_key{~callback_key_t(0)};
+    d.set_overrun_hook(1ms, [&](callback_key_t key, std::chrono::nanoseconds
+                                                        runtime) {
+        EXPECT_GE(runtime, 1ms);
+        overrun_key = key;
+    });
+    const auto fast = d.schedule_every(1ms, []() {});
+    const auto slow = d.schedule_every(5ms, [&]() {
+        std::this_thread::sleep_for(2ms);
+        slow_runs++;
+    });
+    while (slow_runs < 5)
+        std::this_thread::yield();
+
+    const auto profile = d.profile();
+    ASSERT_EQ(profile.size(), 2u);
+    EXPECT_EQ(profile[0].key, fast);
+    EXPECT_GE(profile[0].runs, 5u);
+    EXPECT_EQ(profile[0].overruns, 0u);
+    EXPECT_LT(profile[0].runtime_p50, 1ms);
+    EXPECT_EQ(profile[1].key, slow);
+    EXPECT_GE(profile[1].runs, 5u);
+    EXPECT_GE(profile[1].overruns, 5u);
+    EXPECT_GE(profile[1].runtime_p50, 2ms);
+    EXPECT_GE(profile[1].interval_p50, 4ms);
+    EXPECT_EQ(overrun_key, slow);
+    d.remove_callback(fast);
+    d.remove_callback(slow);
+#else
+    GTEST_SKIP() << "built without HQLOCKFREE_DAEMON_PROFILING";
+#endif
+}
+
+/* every pass runs the slow callback, then the empty one: a slow overrun
+ * hook in between must not be billed to the empty one */
+TEST(Daemon, OverrunHookIsNotBilledToTheNextRun) {
+#if defined(HQLOCKFREE_DAEMON_PROFILING)
+    hqlockfree::daemon d;
+    std::atomic<int> slow_runs{0};
+    d.set_overrun_hook(1ms, [](callback_key_t, std::chrono::nanoseconds) {
+        std::this_thread::sleep_for(3ms);
+    });
+    const auto slow = d.add_callback([&]() {
+        std::this_thread::sleep_for(2ms);
+        slow_runs++;
+    });
+    const auto empty = d.add_callback([]() {});
+    while (slow_runs < 5)
+        std::this_thread::yield();
+
+    const auto profile = d.profile();
+    ASSERT_EQ(profile.size(), 2u);
+    EXPECT_EQ(profile[0].key, slow);
+    EXPECT_GE(profile[0].overruns, 5u);
+    EXPECT_EQ(profile[1].key, empty);
+    EXPECT_GE(profile[1].runs, 4u);
+    EXPECT_EQ(profile[1].overruns, 0u);
+    d.remove_callback(slow);
+    d.remove_callback(empty);
+#else
+    GTEST_SKIP() << "built without HQLOCKFREE_DAEMON_PROFILING";
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <hqlockfree/cache_utils.hpp>
+#include <hqlockfree/cpu_topology.hpp>
+#include <hqlockfree/interference.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+using namespace hqlockfree;
+
+TEST(Interference, PaddingFollowsConfiguredSize) {
+    static_assert(alignof(cache_padded<std::atomic<uint64_t>>) ==
+                  destructive_interference_size);
+    static_assert(sizeof(cache_padded<std::atomic<uint64_t>>) ==
+                  destructive_interference_size);
+    EXPECT_GE(destructive_interference_size, cache_line_size);
+}
+
+TEST(Interference, ProbeRecommendsAPowerOfTwo) {
+    const auto report = probe_interference();
+    EXPECT_TRUE(std::has_single_bit(report.recommended));
+    EXPECT_GE(report.recommended, report.coherency_line_size);
+    EXPECT_GE(report.recommended, report.measured);
+    if (report.measured != 0) {
+        EXPECT_GE(report.measured, 64u);
+        EXPECT_LE(report.measured, 256u);
+        EXPECT_GT(report.ns_per_op[3], 0.0);
+    }
+}
+
+/* SMT siblings share L1 and would time every separation alike, so the
+ * probe measures only between two physical cores this thread may use. */
+TEST(Interference, MeasuresOnlyAcrossPhysicalCores) {
+    EXPECT_EQ(parse_cpu_list("0-2,5,7-8"),
+              (std::vector<int>{0, 1, 2, 5, 7, 8}));
+
+    const auto allowed = allowed_cpus();
+    std::vector<cpu_info> usable;
+    for (const auto& c : read_cpu_topology())
+        if (std::find(allowed.begin(), allowed.end(), c.cpu) != allowed.end())
+            usable.push_back(c);
+    const bool two_cores = std::any_of(
+        usable.begin(), usable.end(), [&](const cpu_info& a) {
+            return std::any_of(usable.begin(), usable.end(),
+                               [&](const cpu_info& b) {
+                                   return a.package != b.package ||
+                                          a.core != b.core;
+                               });
+        });
+    EXPECT_EQ(probe_interference().measured != 0, two_cores);
+}
\ No newline at end of file
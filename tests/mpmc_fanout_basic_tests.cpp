@@ -1,7 +1,11 @@
+#include <hqlockfree/mmap_allocator.hpp>
 #include <hqlockfree/mpmc_fanout.hpp>
+#include <hqlockfree/sojourn_sampler.hpp>
 
 #include <gtest/gtest.h>
 
+#include "test_types.hpp"
+
 #include <atomic>
 #include <cstdint>
 #include <thread>
@@ -119,4 +123,161 @@ TEST(MPMCFanoutCorrectness, UnsubscribeAndCleanup) {
     // Wait a short moment for the daemon to prune & update min_tail
     std::this_thread::sleep_for(std::chrono::milliseconds(25));
     EXPECT_EQ(q.size(), 0);
+}
+
+TEST(MPMCFanoutStats, SubscriptionsShareQueueStats) {
+    mpmc_fanout<int, cache_size_policy::pow2, queue_stats> q(1, 8);
+    auto a = q.subscribe();
+    auto b = q.subscribe();
+
+    int out;
+    EXPECT_FALSE(a->pop(out));
+    EXPECT_FALSE(b->pop(out));
+    q.push(1);
+    q.push(2);
+    ASSERT_TRUE(a->pop(out));
+
+    const auto snap = q.stats().snapshot();
+    EXPECT_EQ(snap.empty_pops, 2u);
+    EXPECT_EQ(snap.high_water_mark, 2u);
+    EXPECT_EQ(snap.cas_failures, 0u);
+}
+
+TEST(MPMCFanoutStats, SojournSampledPerSubscription) {
+    mpmc_fanout<int, cache_size_policy::pow2, sojourn_sampler<1>> q(1, 8);
+    auto a = q.subscribe();
+    auto b = q.subscribe();
+    q.push(1);
+    q.push(2);
+
+    int out;
+    while (a->pop(out)) {
+    }
+    ASSERT_TRUE(b->pop(out));
+    EXPECT_EQ(q.stats().sojourn().count(), 3u);
+}
+
+TEST(MPMCFanoutAllocator, MmapBackend) {
+    mmap_allocator<int> alloc({.huge_pages = false});
+    mpmc_fanout<int, cache_size_policy::pow2, no_stats, mmap_allocator<int>> q(
+        1, 8, alloc);
+    auto sub = q.subscribe();
+    q.push(11);
+    int out = 0;
+    ASSERT_TRUE(sub->pop(out));
+    EXPECT_EQ(out, 11);
+}
+
+TEST(MPMCFanoutFixed, SubscribersSeeEveryElement) {
+    fixed_mpmc_fanout<int, 16> q;
+    EXPECT_EQ(q.capacity(), 16u);
+    auto a = q.subscribe();
+    auto b = q.subscribe();
+    int out;
+    for (int i = 0; i < 100; ++i) {
+        q.push(i);
+        ASSERT_TRUE(a->pop(out));
+        EXPECT_EQ(out, i);
+        ASSERT_TRUE(b->pop(out));
+        EXPECT_EQ(out, i);
+    }
+}
+
+TEST(MPMCFanoutTypes, SlotsLiveUntilReusedThenDestroyed) {
+    {
+        mpmc_fanout<Counted> q(0, 16);
+        auto sub = q.subscribe();
+        EXPECT_EQ(Counted::live, 0);
+        Counted out{-1};
+        for (int i = 0; i < 40; ++i) {
+            q.emplace(i);
+            ASSERT_TRUE(sub->pop(out));
+            ASSERT_EQ(out.v, i);
+            /* let the daemon publish the new minimum tail */
+            while (q.size() != 0)
+                std::this_thread::yield();
+        }
+        /* subscribers copy out, so each slot holds its last element */
+        EXPECT_EQ(Counted::live, int(q.capacity()) + 1);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(MPMCFanoutBulk, EverySubscriberCopiesTheBatch) {
+    mpmc_fanout<uint32_t> q(0, 64);
+    auto first = q.subscribe();
+    auto second = q.subscribe();
+    std::vector<uint32_t> in(40);
+    for (uint32_t i = 0; i < in.size(); ++i)
+        in[i] = i * 7;
+    q.push_n(in.data(), in.size());
+
+    std::vector<uint32_t> out(in.size());
+    ASSERT_EQ(first->pop_n(out.data(), out.size()), in.size());
+    EXPECT_EQ(out, in);
+    std::fill(out.begin(), out.end(), 0);
+    size_t got = 0;
+    while (got < in.size())
+        got += second->pop_n(out.data() + got, 16);
+    EXPECT_EQ(out, in);
+    EXPECT_EQ(first->pop_n(out.data(), 1), 0u);
+}
+
+TEST(MPMCFanoutPrefetch, SubscribersPrefetchIndependently) {
+    mpmc_fanout<uint32_t, cache_size_policy::pow2, no_stats,
+                std::allocator<uint32_t>, destructive_interference_size,
+                tunable_prefetch>
+        q(0, 16);
+    q.prefetch().distance = 4;
+    auto near = q.subscribe();
+    auto far = q.subscribe();
+    near->prefetch().distance = 1;
+    far->prefetch().distance = 64;
+
+    uint32_t a = 0, b = 0;
+    for (uint32_t i = 0; i < 50; ++i) {
+        q.push(i);
+        ASSERT_TRUE(near->pop(a));
+        ASSERT_TRUE(far->pop(b));
+        ASSERT_EQ(a, i);
+        ASSERT_EQ(b, i);
+    }
+}
+
+TEST(MPMCFanoutWarmUp, DestroysDummiesAndRewinds) {
+    {
+        mpmc_fanout<Counted> q(0, 16);
+        q.warm_up(50, Counted(-1));
+        EXPECT_EQ(Counted::live, 0);
+        EXPECT_EQ(q.size(), 0u);
+
+        auto sub = q.subscribe();
+        EXPECT_EQ(sub->get_tail(), 0u);
+        Counted out(0);
+        EXPECT_FALSE(sub->pop(out));
+        q.push(Counted(7));
+        ASSERT_TRUE(sub->pop(out));
+        EXPECT_EQ(out.v, 7);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+/* Wrapping the ring needs the min tail published by the injected daemon;
+ * afterwards the daemon keeps running past the fan‑outs it scanned. */
+TEST(MPMCFanoutDaemon, ScansOnTheInjectedDaemon) {
+    hqlockfree::daemon maintenance(2);
+    for (int round = 0; round < 3; ++round) {
+        fixed_mpmc_fanout<uint32_t, 16> fixed(maintenance);
+        mpmc_fanout<uint32_t> q(maintenance, 0, 16);
+        auto sub = q.subscribe();
+        auto fixed_sub = fixed.subscribe();
+        uint32_t out = 0;
+        for (uint32_t i = 0; i < 5 * q.capacity(); ++i) {
+            q.push(i);
+            fixed.push(i);
+            ASSERT_TRUE(sub->pop(out));
+            ASSERT_EQ(out, i);
+            ASSERT_TRUE(fixed_sub->pop(out));
+        }
+    }
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 // mpsc_queue_basic_tests.cpp
+#include <hqlockfree/mmap_allocator.hpp>
 #include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/sojourn_sampler.hpp>
 
 #include <gtest/gtest.h>
 
+#include "test_types.hpp"
+
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <thread>
 #include <unordered_set>
 #include <vector>
@@ -93,6 +98,23 @@ TEST(MPSCQueueTypes, MoveOnlyElements) {
     EXPECT_EQ(out.v, 7);
 }
 
+TEST(MPSCQueueTypes, SlotsAreConstructedOnPushAndDestroyedOnPop) {
+    {
+        mpsc_queue<Counted> q(0, 1 << 16);
+        EXPECT_EQ(Counted::live, 0); // no slot constructed up front
+        for (int i = 0; i < 5; ++i)
+            q.emplace(i);
+        EXPECT_EQ(Counted::live, 5);
+
+        Counted out{-1};
+        ASSERT_TRUE(q.pop(out));
+        ASSERT_TRUE(q.pop(out));
+        EXPECT_EQ(out.v, 1);
+        EXPECT_EQ(Counted::live, 4); // 3 queued + out
+    }
+    EXPECT_EQ(Counted::live, 0); // the destructor cleaned up the rest
+}
+
 /* --------------------------------------------------------------------------
  *  4. Index wrap-around
  * --------------------------------------------------------------------------*/
@@ -182,4 +204,160 @@ TEST(MPSCQueueConcurrency, ManyProducersSingleConsumer) {
     consumer.join();
     EXPECT_EQ(produced.load(), total_items);
     EXPECT_EQ(consumed.load(), total_items);
+}
+
+/* --------------------------------------------------------------------------
+ *  7. Statistics policy
+ * --------------------------------------------------------------------------*/
+TEST(MPSCQueueStats, CountsEmptyPopsAndHighWaterMark) {
+    mpsc_queue<int, cache_size_policy::pow2, queue_stats> q(1, 16);
+    int out;
+    EXPECT_FALSE(q.pop(out));
+    EXPECT_FALSE(q.pop(out));
+
+    for (int i = 0; i < 5; ++i)
+        q.push(i);
+    for (int i = 0; i < 5; ++i)
+        ASSERT_TRUE(q.pop(out));
+    q.push(5);
+
+    const auto snap = q.stats().snapshot();
+    EXPECT_EQ(snap.empty_pops, 2u);
+    EXPECT_EQ(snap.high_water_mark, 5u);
+    EXPECT_EQ(snap.full_waits, 0u);
+    EXPECT_EQ(snap.cas_failures, 0u); // single producer never retries
+
+    q.stats().reset();
+    EXPECT_EQ(q.stats().snapshot().high_water_mark, 0u);
+}
+
+TEST(MPSCQueueStats, CountsFullWaits) {
+    mpsc_queue<int, cache_size_policy::pow2, queue_stats> q(1, 4);
+    for (size_t i = 0; i + 1 < q.capacity(); ++i)
+        q.push(static_cast<int>(i));
+
+    std::thread producer([&] { q.push(999); });
+    while (q.stats().snapshot().full_waits == 0) {
+        std::this_thread::yield();
+    }
+    int out;
+    ASSERT_TRUE(q.pop(out));
+    producer.join();
+
+    EXPECT_GT(q.stats().snapshot().full_waits, 0u);
+    EXPECT_EQ(q.stats().snapshot().high_water_mark, q.capacity() - 1);
+}
+
+TEST(MPSCQueueStats, NoStatsIsFree) {
+    EXPECT_TRUE(std::is_empty_v<no_stats>);
+    EXPECT_EQ(sizeof(mpsc_queue<int>),
+              (sizeof(mpsc_queue<int, cache_size_policy::pow2, no_stats>)));
+}
+
+TEST(MPSCQueueStats, SojournSamplerLayersOnQueueStats) {
+    mpsc_queue<int, cache_size_policy::pow2, sojourn_sampler<2, queue_stats>>
+        q(1, 16);
+    int out;
+    EXPECT_FALSE(q.pop(out));
+    for (int i = 0; i < 8; ++i)
+        q.push(i);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    for (int i = 0; i < 8; ++i)
+        ASSERT_TRUE(q.pop(out));
+
+    EXPECT_EQ(q.stats().sojourn().count(), 4u);
+    EXPECT_GE(tsc_clock::to_ns(q.stats().sojourn().percentile(0.0)), 1e6);
+    EXPECT_EQ(q.stats().snapshot().empty_pops, 1u);
+    EXPECT_EQ(q.stats().snapshot().high_water_mark, 8u);
+}
+
+TEST(MPSCQueueAllocator, MmapBackendFallsBackGracefully) {
+    // whether the hugetlb pool, THP or mlock are available depends on the
+    // host; the queue must work either way
+    mmap_allocator<int> alloc({.huge_pages = true, .lock = true});
+    mpsc_queue<int, cache_size_policy::pow2, no_stats, mmap_allocator<int>> q(
+        0, 1 << 20, alloc);
+    EXPECT_GE(q.capacity(), size_t(1) << 20);
+
+    const auto& info = alloc.info();
+    EXPECT_FALSE(info.huge_tlb && info.transparent);
+    EXPECT_TRUE(info.populated);
+
+    int out;
+    for (int i = 0; i < 1000; ++i)
+        q.push(i);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(q.pop(out));
+        EXPECT_EQ(out, i);
+    }
+}
+
+TEST(MPSCQueueFixed, MultiProducerMatchesRuntimeSized) {
+    fixed_mpsc_queue<int, 4096, cache_size_policy::pow2, queue_stats> q;
+    EXPECT_EQ(q.capacity(), 4096u);
+
+    constexpr int per_producer = 1000; // fits: no full waits
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 3; ++p)
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i)
+                q.push(p * per_producer + i);
+        });
+
+    std::unordered_set<int> seen;
+    int out;
+    while (seen.size() < size_t(3 * per_producer)) {
+        if (q.pop(out)) {
+            ASSERT_TRUE(seen.insert(out).second);
+        }
+    }
+    for (auto& t : producers)
+        t.join();
+    EXPECT_LE(q.stats().snapshot().high_water_mark, q.capacity() - 1);
+}
+
+TEST(MPSCQueueBulk, ProducersKeepBatchOrder) {
+    mpsc_queue<uint64_t> q(0, 256);
+    constexpr uint64_t batches = 100, batch = 50;
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < 2; ++p)
+        producers.emplace_back([&, p] {
+            std::vector<uint64_t> values(batch);
+            for (uint64_t b = 0; b < batches; ++b) {
+                for (uint64_t i = 0; i < batch; ++i)
+                    values[i] = (p << 32) | (b * batch + i);
+                q.push_n(values.data(), batch);
+            }
+        });
+
+    uint64_t next[2] = {0, 0};
+    std::vector<uint64_t> out(64);
+    uint64_t received = 0;
+    while (received < 2 * batches * batch) {
+        const size_t n = q.pop_n(out.data(), out.size());
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t p = out[i] >> 32;
+            ASSERT_EQ(out[i] & 0xffffffffULL, next[p]++);
+        }
+        received += n;
+    }
+    for (auto& t : producers)
+        t.join();
+}
+
+TEST(MPSCQueueWarmUp, ProducersStartFromACleanRing) {
+    mpsc_queue<int, cache_size_policy::pow2, queue_stats> q(1, 16);
+    q.warm_up(100, 42);
+    EXPECT_EQ(q.size(), 0u);
+    EXPECT_EQ(q.stats().snapshot().high_water_mark, 0u);
+
+    for (int i = 0; i + 1 < static_cast<int>(q.capacity()); ++i)
+        q.push(i);
+    EXPECT_EQ(q.stats().snapshot().full_waits, 0u);
+    int out = 0;
+    for (int i = 0; i + 1 < static_cast<int>(q.capacity()); ++i) {
+        ASSERT_TRUE(q.pop(out));
+        ASSERT_EQ(out, i);
+    }
+    EXPECT_FALSE(q.pop(out));
 }
\ No newline at end of file
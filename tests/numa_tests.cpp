@@ -0,0 +1,95 @@
+#include <hqlockfree/mmap_allocator.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/numa.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+using namespace hqlockfree;
+
+/* These run on any machine; on a single‑node host every placement resolves
+ * to node 0. */
+
+TEST(NUMA, TopologyIsConsistent) {
+    EXPECT_GE(numa_node_count(), 1);
+    EXPECT_NE(numa_online_nodes() & 1, 0u);
+    const int node = current_numa_node();
+    EXPECT_GE(node, 0);
+    EXPECT_LT(node, 64);
+    EXPECT_EQ(numa_node_of_cpu(0), 0);
+}
+
+TEST(NUMA, NodeOutsideTheMaskThrows) {
+    EXPECT_EQ(numa_placement::on_node(63).nodes, uint64_t(1) << 63);
+    EXPECT_THROW(numa_placement::on_node(64), std::invalid_argument);
+    EXPECT_THROW(numa_placement::on_node(-1), std::invalid_argument);
+}
+
+TEST(NUMA, AllocatorBindsRingToNode) {
+    mmap_options options;
+    options.huge_pages = false;
+    options.numa = numa_placement::on_node(0);
+    mmap_allocator<uint64_t> alloc(options);
+
+    uint64_t* data = alloc.allocate(1 << 16);
+    data[0] = 1;
+    const int node = numa_node_of(data);
+    if (alloc.info().numa_bound) {
+        EXPECT_EQ(node, 0);
+    }
+    EXPECT_TRUE(node == 0 || node == -1);
+    alloc.deallocate(data, 1 << 16);
+}
+
+TEST(NUMA, InterleavedRingWorks) {
+    mmap_options options;
+    options.huge_pages = false;
+    options.numa = numa_placement::interleaved(0);
+    mmap_allocator<int> alloc(options);
+    mpsc_queue<int, cache_size_policy::pow2, no_stats, mmap_allocator<int>> q(
+        0, 1 << 16, alloc);
+
+    int out;
+    for (int i = 0; i < 100; ++i) {
+        q.push(i);
+        ASSERT_TRUE(q.pop(out));
+        EXPECT_EQ(out, i);
+    }
+}
+
+TEST(NUMA, PlacedQueueCursorsLiveOnNode) {
+    numa_placed<spsc_queue<int>> q(numa_placement::on_node(0), 1, 8);
+    const int node = numa_node_of(q.get());
+    EXPECT_TRUE(node == 0 || node == -1);
+
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i)
+            q->push(i);
+    });
+    int out;
+    for (int i = 0; i < 1000; ++i) {
+        while (!q->pop(out)) {
+        }
+        ASSERT_EQ(out, i);
+    }
+    producer.join();
+}
+
+TEST(NUMA, FirstTouchFallbackFaultsEveryPage) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t length = 8 * page;
+    void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(memory, MAP_FAILED);
+
+    first_touch(memory, length, numa_placement::interleaved(0));
+    unsigned char resident[8] = {};
+    ASSERT_EQ(mincore(memory, length, resident), 0);
+    for (unsigned char r : resident)
+        EXPECT_TRUE(r & 1);
+    munmap(memory, length);
+}
\ No newline at end of file
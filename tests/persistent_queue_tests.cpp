@@ -0,0 +1,127 @@
+#include <hqlockfree/persistent_queue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace hqlockfree;
+
+namespace {
+
+struct record {
+    uint64_t sequence;
+    uint64_t check; ///< ~sequence, to spot torn slots
+};
+
+using record_queue = persistent_mpsc_queue<record, 1024>;
+
+/// @brief A fresh path under the temp directory, removed again on exit.
+struct temp_file {
+    std::filesystem::path path;
+    explicit temp_file(const std::string& name)
+        : path(std::filesystem::temp_directory_path() /
+               (name + "." + std::to_string(getpid()))) {
+        std::filesystem::remove(path);
+    }
+    ~temp_file() { std::filesystem::remove(path); }
+};
+
+} // namespace
+
+TEST(PersistentQueue, ReopenResumesFromStoredTail) {
+    temp_file file("hqlockfree_reopen");
+    {
+        record_queue q(file.path);
+        EXPECT_FALSE(q.recovered());
+        for (uint64_t i = 0; i < 100; ++i)
+            q->push({i, ~i});
+        record out;
+        for (uint64_t i = 0; i < 30; ++i)
+            ASSERT_TRUE(q->pop(out));
+    }
+    record_queue q(file.path);
+    EXPECT_TRUE(q.recovered());
+    EXPECT_EQ(q->size(), 70u);
+    record out;
+    for (uint64_t i = 30; i < 100; ++i) {
+        ASSERT_TRUE(q->pop(out));
+        ASSERT_EQ(out.sequence, i);
+    }
+    EXPECT_FALSE(q->pop(out));
+}
+
+TEST(PersistentQueue, RejectsOtherLayoutsAndSecondOpen) {
+    temp_file file("hqlockfree_layout");
+    {
+        record_queue q(file.path);
+        EXPECT_THROW(record_queue again(file.path), std::system_error);
+    }
+    using smaller = persistent_mpsc_queue<record, 512>;
+    EXPECT_THROW(smaller other(file.path), std::runtime_error);
+    record_queue q(file.path);
+    EXPECT_TRUE(q.recovered());
+}
+
+/* The child pushes and pops without pause until it is SIGKILLed at an
+ * arbitrary point; every record committed before that must come back intact
+ * and in order, and the queue must keep working. */
+TEST(PersistentQueue, SurvivesCrashMidStream) {
+    temp_file file("hqlockfree_crash");
+    int ready[2];
+    ASSERT_EQ(pipe(ready), 0);
+
+    const pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        record_queue q(file.path);
+        record out;
+        for (uint64_t i = 0;; ++i) {
+            q->push({i, ~i});
+            if (i >= 500)
+                q->pop(out);
+            if (i == 10000) {
+                const char byte = 1;
+                if (write(ready[1], &byte, 1) != 1)
+                    _exit(1);
+            }
+        }
+    }
+    char byte = 0;
+    ASSERT_EQ(read(ready[0], &byte, 1), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    kill(child, SIGKILL);
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    close(ready[0]);
+    close(ready[1]);
+
+    record_queue q(file.path);
+    ASSERT_TRUE(q.recovered());
+    const size_t queued = q->size();
+    EXPECT_GE(queued, 499u);
+    EXPECT_LE(queued, 501u);
+    record out;
+    ASSERT_TRUE(q->pop(out));
+    uint64_t expected = out.sequence;
+    ASSERT_EQ(out.check, ~out.sequence);
+    for (size_t k = 1; k < queued; ++k) {
+        ASSERT_TRUE(q->pop(out));
+        ASSERT_EQ(out.sequence, ++expected);
+        ASSERT_EQ(out.check, ~out.sequence);
+    }
+    EXPECT_FALSE(q->pop(out));
+
+    q->push({7, ~uint64_t(7)});
+    ASSERT_TRUE(q->pop(out));
+    EXPECT_EQ(out.sequence, 7u);
+}
\ No newline at end of file
@@ -53,6 +53,18 @@ TEST(SPMCPushVecBasic, CapacityGrowth) {
     EXPECT_EQ(*first_it, 1);
 }
 
+TEST(SPMCPushVecBasic, RetainedCapacity) {
+    spmc_push_vec<int> vec(4);
+    EXPECT_EQ(vec.retained_capacity(), vec.capacity());
+
+    for (int i = 0; i < 5; i++)
+        vec.push_back(i); // grows once
+    EXPECT_EQ(vec.retained_capacity(), 4u + vec.capacity());
+
+    vec.drop_old();
+    EXPECT_EQ(vec.retained_capacity(), vec.capacity());
+}
+
 TEST(SPMCPushVecCorrectness, ResizeRules) {
     spmc_push_vec<int> vec(2);
     vec.resize(5);
@@ -1,11 +1,19 @@
+#include <hqlockfree/mmap_allocator.hpp>
+#include <hqlockfree/sojourn_sampler.hpp>
 #include <hqlockfree/spsc_queue.hpp>
 
 #include <gtest/gtest.h>
 
+#include "test_types.hpp"
+
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <numeric>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace hqlockfree;
 
@@ -120,4 +128,184 @@ TEST(SPSCQueueProperties, SizeAndCapacity) {
         q.pop(dummy);
         EXPECT_EQ(q.size(), static_cast<std::size_t>(i));
     }
+}
+
+TEST(SPSCQueueStats, CountsEmptyPopsFullWaitsAndDepth) {
+    spsc_queue<int, cache_size_policy::pow2, queue_stats> q(1, 4);
+    int out;
+    EXPECT_FALSE(q.pop(out));
+    EXPECT_EQ(q.stats().snapshot().empty_pops, 1u);
+
+    for (size_t i = 0; i + 1 < q.capacity(); ++i)
+        q.push(static_cast<int>(i));
+    EXPECT_EQ(q.stats().snapshot().high_water_mark, q.capacity() - 1);
+
+    std::thread producer([&] { q.push(999); });
+    while (q.stats().snapshot().full_waits == 0) {
+        std::this_thread::yield();
+    }
+    ASSERT_TRUE(q.pop(out));
+    producer.join();
+    EXPECT_GT(q.stats().snapshot().full_waits, 0u);
+}
+
+TEST(SPSCQueueStats, SojournSamplerRecordsSampledIndices) {
+    spsc_queue<int, cache_size_policy::pow2, sojourn_sampler<4>> q(1, 8);
+    int out;
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < 6; ++i)
+            q.push(i);
+        for (int i = 0; i < 6; ++i)
+            ASSERT_TRUE(q.pop(out));
+    }
+    // indices 0, 4, 8, ..., 20 of 24 pushed
+    EXPECT_EQ(q.stats().sojourn().count(), 6u);
+    EXPECT_GE(q.stats().sojourn().max(), q.stats().sojourn().percentile(0.5));
+}
+
+TEST(SPSCQueueAllocator, MmapBackendSmallPages) {
+    mmap_allocator<int> alloc({.huge_pages = false, .populate = true});
+    spsc_queue<int, cache_size_policy::pow2, no_stats, mmap_allocator<int>> q(
+        4, 0, alloc);
+    EXPECT_TRUE(alloc.info().populated);
+    EXPECT_FALSE(alloc.info().huge_tlb);
+
+    int out;
+    for (int i = 0; i < 100; ++i) {
+        q.push(i);
+        ASSERT_TRUE(q.pop(out));
+        EXPECT_EQ(out, i);
+    }
+}
+
+TEST(SPSCQueueFixed, CapacityIsCompileTime) {
+    using queue = fixed_spsc_queue<int, 100>;
+    using exact_queue = fixed_spsc_queue<int, 100, cache_size_policy::exact>;
+    queue q;
+    exact_queue exact;
+    EXPECT_EQ(q.capacity(), 128u);     // 7 lines of 16, rounded to 8
+    EXPECT_EQ(exact.capacity(), 112u); // 7 lines of 16
+    EXPECT_GE(sizeof(queue), 128 * sizeof(int));
+}
+
+TEST(SPSCQueueFixed, WrapsAroundInStaticStorage) {
+    static fixed_spsc_queue<int, 32> q;
+    int out;
+    for (int i = 0; i < 1000; ++i) {
+        q.push(i);
+        ASSERT_TRUE(q.pop(out));
+        ASSERT_EQ(out, i);
+    }
+    EXPECT_FALSE(q.pop(out));
+}
+
+TEST(SPSCQueueLayout, LargeElementsGetWholeInterferenceBlocks) {
+    struct large {
+        uint64_t sequence;
+        char padding[192];
+    };
+    using line64 = cache_line<large, cache_size_policy::pow2, 64>;
+    using line128 = cache_line<large, cache_size_policy::pow2, 128>;
+    static_assert(sizeof(line64) == 256 && alignof(line64) == 64);
+    static_assert(sizeof(line128) == 256 && alignof(line128) == 128);
+    static_assert(alignof(cache_line<int, cache_size_policy::pow2, 128>) ==
+                  cache_line_size); // small elements keep the line layout
+
+    false_sharing_optimized_buffer<large, cache_size_policy::pow2,
+                                   std::allocator<large>, 128>
+        buffer(0, 8);
+    for (size_t i = 0; i < buffer.size(); ++i)
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(&buffer[i]) % 128, 0u);
+
+    spsc_queue<large, cache_size_policy::pow2, no_stats, std::allocator<large>,
+               128>
+        q(0, 8);
+    large out{};
+    for (uint64_t i = 0; i < 100; ++i) {
+        q.push(large{i, {}});
+        ASSERT_TRUE(q.pop(out));
+        EXPECT_EQ(out.sequence, i);
+    }
+}
+
+TEST(SPSCQueueTypes, NonDefaultConstructibleElements) {
+    {
+        fixed_spsc_queue<Counted, 32> q;
+        EXPECT_EQ(Counted::live, 0);
+        Counted out{-1};
+        for (int i = 0; i < 100; ++i) { // wraps the ring several times
+            q.emplace(i);
+            ASSERT_TRUE(q.pop(out));
+            ASSERT_EQ(out.v, i);
+        }
+        q.push(Counted{100});
+        q.push(Counted{101});
+        EXPECT_EQ(Counted::live, 3);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(SPSCQueueBulk, PushNPopNAcrossWrapAround) {
+    spsc_queue<int> q(0, 64); // 4 lines of 16: runs wrap across lines
+    std::vector<int> in(1000);
+    std::iota(in.begin(), in.end(), 0);
+    std::vector<int> out(in.size());
+
+    size_t pushed = 0, popped = 0;
+    while (popped < in.size()) {
+        const size_t n = std::min<size_t>(37, in.size() - pushed);
+        if (n != 0 && q.size() + n < q.capacity()) {
+            q.push_n(in.data() + pushed, n);
+            pushed += n;
+        }
+        popped += q.pop_n(out.data() + popped, 23);
+    }
+    EXPECT_EQ(out, in);
+    EXPECT_EQ(q.pop_n(out.data(), 1), 0u);
+}
+
+TEST(SPSCQueueBulk, NonTriviallyCopyableElements) {
+    fixed_spsc_queue<std::string, 16> q;
+    const std::vector<std::string> in = {"a", "bb", "a string too long for SSO",
+                                         "d"};
+    std::vector<std::string> out(in.size());
+    for (int round = 0; round < 10; ++round) {
+        q.push_n(in.data(), in.size());
+        ASSERT_EQ(q.pop_n(out.data(), out.size()), in.size());
+        ASSERT_EQ(out, in);
+    }
+}
+
+TEST(SPSCQueuePrefetch, DistancePastTheRingWrapsHarmlessly) {
+    spsc_queue<uint64_t, cache_size_policy::pow2, no_stats,
+               std::allocator<uint64_t>, destructive_interference_size,
+               tunable_prefetch>
+        q(0, 16);
+    EXPECT_EQ(q.prefetch().distance, 0u);
+    q.prefetch().distance = q.capacity() * 3 + 5;
+
+    uint64_t out = 0;
+    for (uint64_t i = 0; i < 100; ++i) {
+        q.push(i);
+        ASSERT_TRUE(q.pop(out));
+        ASSERT_EQ(out, i);
+    }
+    EXPECT_FALSE(q.pop(out));
+}
+
+TEST(SPSCQueueWarmUp, LeavesQueueAsConstructed) {
+    spsc_queue<int, cache_size_policy::pow2, queue_stats> q(1, 16);
+    q.warm_up(100);
+    EXPECT_EQ(q.size(), 0u);
+    const auto stats = q.stats().snapshot();
+    EXPECT_EQ(stats.high_water_mark, 0u);
+    EXPECT_EQ(stats.empty_pops, 0u);
+
+    int out = 0;
+    EXPECT_FALSE(q.pop(out));
+    for (int i = 0; i < 40; ++i) {
+        q.push(i);
+        ASSERT_TRUE(q.pop(out));
+        ASSERT_EQ(out, i);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+/// @brief No default constructor; counts live instances.
+struct Counted {
+    static inline int live = 0;
+    int v;
+    explicit Counted(int vv) : v(vv) { ++live; }
+    Counted(const Counted& other) : v(other.v) { ++live; }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() { --live; }
+};
\ No newline at end of file
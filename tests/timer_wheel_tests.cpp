@@ -0,0 +1,93 @@
+#include <hqlockfree/timer_wheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace hqlockfree;
+
+/* Due times spread over every level and the overflow list, advanced in
+ * irregular steps: each entry must expire exactly when the time reaches it,
+ * in due order, including those scheduled from inside the expiry callback.
+ * Some of those are already due; they must expire on the very next tick. */
+TEST(TimerWheel, ExpiresEachEntryOnTimeAndInOrder) {
+    std::mt19937_64 rng(42);
+    timer_wheel<uint64_t> wheel(1000);
+    std::vector<uint64_t> due_of, at_of; ///< at: when it should expire
+    std::multiset<uint64_t> pending;     ///< at of those not yet expired
+    auto schedule = [&](uint64_t due, uint64_t at) {
+        wheel.schedule(due, due_of.size());
+        due_of.push_back(due);
+        at_of.push_back(at);
+        pending.insert(at);
+    };
+    for (int i = 0; i < 5000; ++i) {
+        const auto due = 1000 + (rng() >> (rng() % 64)) % (uint64_t(1) << 26);
+        schedule(due, due);
+    }
+
+    std::vector<bool> expired(due_of.size(), false);
+    uint64_t now = 1000, last = 0;
+    size_t count = 0;
+    while (!wheel.empty()) {
+        now += 1 + rng() % 5000;
+        wheel.advance(now, [&](uint64_t due, uint64_t id) {
+            ASSERT_EQ(due, due_of[id]);
+            ASSERT_LE(at_of[id], now);
+            ASSERT_GE(at_of[id], last);
+            ASSERT_FALSE(expired[id]);
+            expired[id] = true;
+            pending.erase(pending.find(at_of[id]));
+            last = at_of[id];
+            ++count;
+            if (count % 7 == 0 && due_of.size() < 8000) {
+                const uint64_t later = now + 1 + rng() % 100000;
+                schedule(later, later);
+                expired.push_back(false);
+            } else if (count % 5 == 0 && due_of.size() < 8000) {
+                schedule(last - rng() % 3, last + 1);
+                expired.push_back(false);
+            }
+        });
+        ASSERT_EQ(pending.size(), wheel.size());
+        if (!pending.empty()) {
+            ASSERT_GT(*pending.begin(), now);
+        }
+    }
+    EXPECT_EQ(count, due_of.size());
+}
+
+/* An hour of microseconds is ~2^31.7 ticks, well past the 2^24 the levels
+ * cover: idle stretches must be skipped, not walked 64 ticks at a time, and
+ * entries out there must still expire exactly on time. */
+TEST(TimerWheel, SkipsLongIdleStretchesQuickly) {
+    constexpr uint64_t hour = uint64_t(3600) * 1000 * 1000;
+    const auto start = std::chrono::steady_clock::now();
+
+    timer_wheel<int> wheel;
+    wheel.advance(hour, [](uint64_t, int) { FAIL(); });
+    EXPECT_EQ(wheel.now(), hour + 1);
+
+    const uint64_t far[] = {2 * hour + 17, 5 * hour, 5 * hour + 64};
+    for (int i = 0; i < 3; ++i)
+        wheel.schedule(far[i], i);
+    std::vector<uint64_t> fired;
+    auto record = [&](uint64_t due, int id) {
+        EXPECT_EQ(due, far[id]);
+        fired.push_back(due);
+    };
+    for (size_t i = 0; i < 3; ++i) {
+        wheel.advance(far[i] - 1, record);
+        EXPECT_EQ(fired.size(), i);
+        wheel.advance(far[i], record);
+        EXPECT_EQ(fired.size(), i + 1);
+    }
+    EXPECT_TRUE(wheel.empty());
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(50));
+}
\ No newline at end of file
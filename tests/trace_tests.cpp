@@ -0,0 +1,113 @@
+#include <hqlockfree/mpmc_fanout.hpp>
+#include <hqlockfree/mpsc_queue.hpp>
+#include <hqlockfree/spsc_queue.hpp>
+#include <hqlockfree/trace.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace hqlockfree;
+
+static std::string temp_trace_path(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+static std::string read_file(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+static size_t count_of(const std::string& haystack, const std::string& needle) {
+    size_t n = 0;
+    for (auto pos = haystack.find(needle); pos != std::string::npos;
+         pos = haystack.find(needle, pos + 1))
+        n++;
+    return n;
+}
+
+TEST(Trace, RecordsPushAndPopAsChromeTrace) {
+    const auto path = temp_trace_path("hqlockfree_trace_basic.json");
+    spsc_queue<int, cache_size_policy::pow2, queue_tracer<>> q(1, 8);
+
+    start_tracing(path);
+    int out;
+    for (int i = 0; i < 3; ++i) {
+        q.push(i);
+        ASSERT_TRUE(q.pop(out));
+    }
+    stop_tracing();
+    q.push(99); // not recorded once the session is closed
+
+    const auto json = read_file(path);
+    EXPECT_EQ(json.rfind(R"({"traceEvents":[)", 0), 0u);
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_EQ(count_of(json, R"("name":"push")"), 3u);
+    EXPECT_EQ(count_of(json, R"("name":"pop")"), 3u);
+    EXPECT_EQ(dropped_trace_events(), 0u);
+    std::remove(path.c_str());
+}
+
+TEST(Trace, RecordsFullWaitsAndDaemonScans) {
+    const auto path = temp_trace_path("hqlockfree_trace_waits.json");
+    mpsc_queue<int, cache_size_policy::pow2, queue_tracer<queue_stats>> q(1,
+                                                                          4);
+    mpmc_fanout<int, cache_size_policy::pow2, queue_tracer<>> fanout(1, 8);
+    auto sub = fanout.subscribe();
+
+    start_tracing(path);
+    for (size_t i = 0; i + 1 < q.capacity(); ++i)
+        q.push(static_cast<int>(i));
+    std::thread producer([&] { q.push(999); });
+    while (q.stats().snapshot().full_waits == 0) {
+        std::this_thread::yield();
+    }
+    int out;
+    ASSERT_TRUE(q.pop(out));
+    producer.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop_tracing();
+
+    const auto json = read_file(path);
+    EXPECT_EQ(count_of(json, R"("name":"full_wait","cat":"hqlockfree")"),
+              1u);
+    EXPECT_GT(count_of(json, R"("name":"daemon_scan")"), 0u);
+    EXPECT_NE(json.find(R"("ph":"X")"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+TEST(Trace, SecondSessionThrowsWhileOpen) {
+    const auto path = temp_trace_path("hqlockfree_trace_twice.json");
+    start_tracing(path);
+    EXPECT_THROW(start_tracing(path), std::runtime_error);
+    stop_tracing();
+    EXPECT_NO_THROW(stop_tracing());
+    std::remove(path.c_str());
+}
+
+/// @brief Trace one push and exit without stop_tracing().
+[[noreturn]] static void exit_while_tracing(const std::string& path) {
+    spsc_queue<int, cache_size_policy::pow2, queue_tracer<>> q(1, 8);
+    start_tracing(path);
+    q.push(1);
+    std::exit(0);
+}
+
+TEST(Trace, SessionLeftOpenIsClosedAtExit) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe"); // fresh daemon threads
+    const auto path = temp_trace_path("hqlockfree_trace_exit.json");
+    EXPECT_EXIT(exit_while_tracing(path), ::testing::ExitedWithCode(0), "");
+    const auto json = read_file(path);
+    ASSERT_FALSE(json.empty());
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_EQ(count_of(json, R"("name":"push")"), 1u);
+    std::remove(path.c_str());
+}
\ No newline at end of file